@@ -39,6 +39,7 @@ void *reallocate_block (void *ptr, size_t bytes) {
 }
 
 #include <assert.h>
+#include <stdint.h>
 #include <string.h>
 
 #ifndef NDEBUG
@@ -122,3 +123,58 @@ void deallocate_aligned (size_t alignment, void *ptr) {
   free (start);
 #endif
 }
+
+/*------------------------------------------------------------------------*/
+
+// Large long-lived arrays (watchers, watch list headers and per-variable
+// data) are randomly accessed during propagation and thus suffer from TLB
+// misses on big instances.  If requested, arrays of at least the size of
+// a huge page are aligned to huge pages and backed by transparent huge
+// pages through 'madvise'.  This keeps them 'free'-able as all other
+// arrays, while explicit 'MAP_HUGETLB' mappings would require 'munmap' and
+// a reserved huge page pool.  Without support we fall back to 'calloc'.
+
+#if defined(__linux__) && defined(GIMSATUL_HAS_POSIX_MEMALIGN)
+#include <sys/mman.h>
+#ifdef MADV_HUGEPAGE
+#define GIMSATUL_HAS_HUGE_PAGES
+#endif
+#endif
+
+struct huge_pages huge_pages;
+
+void advise_huge_pages (void *ptr, size_t bytes) {
+#ifdef GIMSATUL_HAS_HUGE_PAGES
+  const uintptr_t mask = HUGE_PAGE_SIZE - 1;
+  uintptr_t begin = ((uintptr_t) ptr + mask) & ~mask;
+  uintptr_t end = ((uintptr_t) ptr + bytes) & ~mask;
+  if (begin >= end)
+    return;
+  size_t advise = end - begin;
+  if (madvise ((void *) begin, advise, MADV_HUGEPAGE))
+    atomic_fetch_add (&huge_pages.failed, 1);
+  else
+    atomic_fetch_add (&huge_pages.advised, advise);
+#else
+  (void) ptr;
+  (void) bytes;
+#endif
+}
+
+void *allocate_and_clear_huge_array (bool huge, size_t num, size_t bytes) {
+#ifdef GIMSATUL_HAS_HUGE_PAGES
+  size_t total = num * bytes;
+  if (huge && total >= HUGE_PAGE_SIZE) {
+    const size_t mask = HUGE_PAGE_SIZE - 1;
+    size_t rounded = (total + mask) & ~mask;
+    void *res = allocate_aligned_array (HUGE_PAGE_SIZE, rounded, 1);
+    advise_huge_pages (res, rounded);
+    memset (res, 0, total);
+    atomic_fetch_add (&huge_pages.arrays, 1);
+    return res;
+  }
+#else
+  (void) huge;
+#endif
+  return allocate_and_clear_array (num, bytes);
+}
@@ -1,6 +1,8 @@
 #ifndef _allocate_h_INCLUDED
 #define _allocate_h_INCLUDED
 
+#include <stdatomic.h>
+#include <stdbool.h>
 #include <stdlib.h>
 
 void *allocate_block (size_t bytes);
@@ -14,6 +16,19 @@ void *allocate_aligned_array (size_t alignment, size_t num, size_t bytes);
 
 void deallocate_aligned (size_t alignment, void *ptr);
 
+#define HUGE_PAGE_SIZE ((size_t) 1 << 21)
+
+void *allocate_and_clear_huge_array (bool huge, size_t num, size_t bytes);
+void advise_huge_pages (void *ptr, size_t bytes);
+
+struct huge_pages {
+  atomic_size_t arrays;
+  atomic_size_t advised;
+  atomic_size_t failed;
+};
+
+extern struct huge_pages huge_pages;
+
 #define FREE(PTR) \
   do { \
     free (PTR); \
@@ -18,6 +18,7 @@
 static void bump_reason (struct ring *ring, struct watcher *watcher) {
   assert (watcher->redundant);
   watcher->used = MAX_USED;
+  watcher->analyzed = true;
   unsigned new_glue = recompute_glue (ring, watcher);
   if (new_glue < watcher->glue)
     promote_watcher (ring, watcher, new_glue);
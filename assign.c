@@ -22,6 +22,9 @@ static void assign (struct ring *ring, unsigned lit, struct watch *reason,
 
   ring->values[lit] = 1;
   ring->values[not_lit] = -1;
+#ifdef PACKED_VALUES
+  assign_packed_value (ring->packed, lit);
+#endif
 
   if (ring->context != PROBING_CONTEXT)
     ring->phases[idx].saved = SGN (lit) ? -1 : 1;
@@ -0,0 +1,487 @@
+#include "async.h"
+#include "assign.h"
+#include "import.h"
+#include "message.h"
+#include "propagate.h"
+#include "ruler.h"
+#include "scale.h"
+#include "search.h"
+#include "simplify.h"
+#include "utilities.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+bool simplifying_asynchronously (struct ring *ring) {
+  if (ring->id)
+    return false;
+  if (!ring->options.simplify)
+    return false;
+  if (!ring->options.simplify_async)
+    return false;
+  if (ring->ruler->options.proof.file)
+    return false;
+  return ring->limits.async <= SEARCH_CONFLICTS;
+}
+
+/*------------------------------------------------------------------------*/
+
+// The size of shadow clauses at snapshot time is remembered in their
+// 'snapshot' field, which allows to find strengthened and new clauses
+// after simplification.
+
+static void snapshot_large_clause (struct ruler *shadow,
+                                   struct unsigneds *literals) {
+  size_t size = SIZE (*literals);
+  assert (size > 1);
+  if (size == 2) {
+    new_ruler_binary_clause (shadow, literals->begin[0],
+                             literals->begin[1]);
+    return;
+  }
+  struct clause *clause = new_large_clause (size, literals->begin, false, 0);
+  clause->snapshot = MIN (size, (unsigned short) ~0);
+  PUSH (shadow->clauses, clause);
+}
+
+static struct ruler *snapshot_irredundant_clauses (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct options options = ruler->options;
+  options.eliminate = false;
+  options.simplify_boost = false;
+  options.substitute_parallel = 0;
+  struct ruler *shadow = new_ruler (ring->size, &options);
+  signed char *values = ring->values;
+  assert (!ring->level);
+  for (all_ring_literals (lit)) {
+    if (values[lit])
+      continue;
+    unsigned *binaries = BINARIES (lit);
+    if (!binaries)
+      continue;
+    for (unsigned *p = binaries, other; (other = *p) != INVALID; p++)
+      if (lit < other && !values[other])
+        new_ruler_binary_clause (shadow, lit, other);
+  }
+  struct unsigneds literals;
+  INIT (literals);
+  for (all_watchers (watcher)) {
+    if (watcher->garbage)
+      continue;
+    if (watcher->redundant)
+      continue;
+    struct clause *clause = watcher->clause;
+    bool satisfied = false;
+    CLEAR (literals);
+    for (all_literals_in_clause (lit, clause)) {
+      signed char value = values[lit];
+      if (value > 0) {
+        satisfied = true;
+        break;
+      }
+      if (!value)
+        PUSH (literals, lit);
+    }
+    if (!satisfied)
+      snapshot_large_clause (shadow, &literals);
+  }
+  RELEASE (literals);
+  struct ruler_statistics *statistics = &shadow->statistics;
+  statistics->original = SIZE (shadow->clauses) + statistics->binaries;
+  return shadow;
+}
+
+/*------------------------------------------------------------------------*/
+
+static uint64_t binary_key (unsigned lit, unsigned other) {
+  assert (lit < other);
+  return ((uint64_t) lit << 32) | other;
+}
+
+static int cmp_binary_keys (const void *p, const void *q) {
+  uint64_t a = *(uint64_t *) p, b = *(uint64_t *) q;
+  return (a > b) - (a < b);
+}
+
+static uint64_t *snapshot_binary_keys (struct ruler *shadow) {
+  struct ruler *ruler = shadow;
+  size_t size = ruler->statistics.binaries, i = 0;
+  uint64_t *keys = allocate_array (size + 1, sizeof *keys);
+  for (all_ruler_literals (lit))
+    for (all_clauses (clause, OCCURRENCES (lit))) {
+      assert (is_binary_pointer (clause));
+      unsigned other = other_pointer (clause);
+      if (lit < other)
+        keys[i++] = binary_key (lit, other);
+    }
+  assert (i == size);
+  qsort (keys, size, sizeof *keys, cmp_binary_keys);
+  return keys;
+}
+
+static void release_published_clauses (struct async *async) {
+  for (all_clauses (clause, async->clauses))
+    if (!atomic_fetch_sub (&clause->shared, 1))
+      free (clause);
+  RELEASE (async->clauses);
+}
+
+static size_t collect_new_binaries (struct ruler *ruler, uint64_t *keys,
+                                    size_t size_keys,
+                                    struct unsigneds *binaries) {
+  signed char *values = (signed char *) ruler->values;
+  size_t collected = 0;
+  for (all_ruler_literals (lit))
+    for (all_clauses (clause, OCCURRENCES (lit))) {
+      if (!is_binary_pointer (clause))
+        continue;
+      unsigned other = other_pointer (clause);
+      if (lit > other)
+        continue;
+      if (values[lit] || values[other])
+        continue;
+      uint64_t key = binary_key (lit, other);
+      if (bsearch (&key, keys, size_keys, sizeof key, cmp_binary_keys))
+        continue;
+      PUSH (*binaries, lit);
+      PUSH (*binaries, other);
+      collected++;
+    }
+  return collected;
+}
+
+static void collect_simplified_clauses (struct ruler *ruler,
+                                        struct ruler *shadow,
+                                        uint64_t *keys, size_t size_keys,
+                                        struct async *result) {
+  struct ruler_statistics *statistics = &ruler->statistics;
+  signed char *values = (signed char *) shadow->values;
+
+  for (all_elements_on_stack (unsigned, unit, shadow->units))
+    PUSH (result->units, unit);
+  statistics->async.units += SIZE (result->units);
+
+  struct unsigneds *extension = &shadow->extension[0];
+  for (unsigned *p = extension->begin; p != extension->end; p += 3) {
+    assert (p[0] == INVALID);
+    PUSH (result->binaries, p[1]);
+    PUSH (result->binaries, p[2]);
+  }
+  statistics->async.equivalences += SIZE (*extension) / 6;
+
+  statistics->async.binaries +=
+      collect_new_binaries (shadow, keys, size_keys, &result->binaries);
+
+  struct unsigneds literals;
+  INIT (literals);
+  for (all_clauses (clause, shadow->clauses)) {
+    if (clause->garbage)
+      continue;
+    bool satisfied = false;
+    CLEAR (literals);
+    for (all_literals_in_clause (lit, clause)) {
+      signed char value = values[lit];
+      if (value > 0) {
+        satisfied = true;
+        break;
+      }
+      if (!value)
+        PUSH (literals, lit);
+    }
+    if (satisfied)
+      continue;
+    size_t size = SIZE (literals);
+    if (size < 2)
+      continue;
+    if (size >= clause->snapshot)
+      continue;
+    if (size == 2) {
+      PUSH (result->binaries, literals.begin[0]);
+      PUSH (result->binaries, literals.begin[1]);
+      statistics->async.binaries++;
+      continue;
+    }
+    struct clause *simplified =
+        new_large_clause (size, literals.begin, true, size - 1);
+    PUSH (result->clauses, simplified);
+    statistics->async.clauses++;
+  }
+  RELEASE (literals);
+}
+
+static void publish_simplified_clauses (struct ruler *ruler,
+                                        struct async *result) {
+  struct async *async = &ruler->async;
+  if (pthread_mutex_lock (&ruler->locks.async))
+    fatal_error ("failed to acquire async lock during publishing");
+  release_published_clauses (async);
+  RELEASE (async->units);
+  RELEASE (async->binaries);
+  async->units = result->units;
+  async->binaries = result->binaries;
+  async->clauses = result->clauses;
+  async->inconsistent = result->inconsistent;
+  atomic_fetch_add (&async->published, 1);
+  if (pthread_mutex_unlock (&ruler->locks.async))
+    fatal_error ("failed to release async lock during publishing");
+}
+
+static void *simplify_asynchronously (void *ptr) {
+  struct ruler *ruler = ptr;
+  struct async *async = &ruler->async;
+  struct ruler *shadow = async->shadow;
+#ifndef QUIET
+  double start = START (ruler, async);
+#endif
+  size_t size_keys = shadow->statistics.binaries;
+  uint64_t *keys = snapshot_binary_keys (shadow);
+  simplify_snapshot (shadow);
+
+  struct async result;
+  memset (&result, 0, sizeof result);
+#ifndef QUIET
+  size_t units = 0, binaries = 0, clauses = 0;
+#endif
+  if (!shadow->terminate) {
+    if (shadow->inconsistent)
+      result.inconsistent = true;
+    else
+      collect_simplified_clauses (ruler, shadow, keys, size_keys,
+                                  &result);
+#ifndef QUIET
+    units = SIZE (result.units);
+    binaries = SIZE (result.binaries) / 2;
+    clauses = SIZE (result.clauses);
+#endif
+    publish_simplified_clauses (ruler, &result);
+  }
+  free (keys);
+
+  if (pthread_mutex_lock (&ruler->locks.async))
+    fatal_error ("failed to acquire async lock during finishing");
+  async->shadow = 0;
+  if (pthread_mutex_unlock (&ruler->locks.async))
+    fatal_error ("failed to release async lock during finishing");
+  delete_ruler (shadow);
+
+#ifndef QUIET
+  double end = STOP (ruler, async);
+  message (0,
+           "asynchronous simplification #%" PRIu64 " published %zu units "
+           "%zu binary and %zu large clauses in %.2f seconds",
+           ruler->statistics.async.simplifications, units, binaries,
+           clauses, end - start);
+#endif
+  atomic_store (&async->running, false);
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void join_asynchronous_simplification (struct ruler *ruler) {
+  struct async *async = &ruler->async;
+  if (!async->started)
+    return;
+  if (pthread_join (async->thread, 0))
+    fatal_error ("failed to join asynchronous simplification thread");
+  async->started = false;
+}
+
+int start_asynchronous_simplification (struct ring *ring) {
+  assert (!ring->id);
+  struct ruler *ruler = ring->ruler;
+  struct async *async = &ruler->async;
+  if (ring->level)
+    backtrack_propagate_iterate (ring);
+  if (!ring->inconsistent && !atomic_load (&async->running)) {
+    join_asynchronous_simplification (ruler);
+    ruler->statistics.async.simplifications++;
+    struct ruler *shadow = snapshot_irredundant_clauses (ring);
+    message (ring,
+             "asynchronous simplification #%" PRIu64 " of %zu clauses",
+             ruler->statistics.async.simplifications,
+             (size_t) shadow->statistics.original);
+    async->shadow = shadow;
+    atomic_store (&async->running, true);
+    async->started = true;
+    if (pthread_create (&async->thread, 0, simplify_asynchronously, ruler))
+      fatal_error ("failed to create asynchronous simplification thread");
+  }
+  struct ring_limits *limits = &ring->limits;
+  uint64_t base = ring->options.simplify_interval;
+  uint64_t simplifications = ruler->statistics.async.simplifications;
+  uint64_t interval = base * nlog2n (simplifications);
+  uint64_t scaled = scale_interval (ring, "async", interval);
+  limits->async = SEARCH_CONFLICTS + scaled;
+  very_verbose (
+      ring, "new async limit at %" PRIu64 " after %" PRIu64 " conflicts",
+      limits->async, scaled);
+  return ring->status;
+}
+
+void adopt_asynchronous_simplification (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct async *async = &ruler->async;
+  if (ring->last.async == atomic_load (&async->published))
+    return;
+  assert (!ring->level);
+  if (ring->inconsistent)
+    return;
+  if (pthread_mutex_lock (&ruler->locks.async))
+    fatal_error ("failed to acquire async lock during adoption");
+  ring->last.async = atomic_load (&async->published);
+  unsigned units = 0, binaries = 0, clauses = 0;
+  if (async->inconsistent) {
+    set_inconsistent (ring, "asynchronous simplification inconsistent");
+    goto UNLOCK;
+  }
+  signed char *values = ring->values;
+  for (all_elements_on_stack (unsigned, unit, async->units)) {
+    signed char value = values[unit];
+    if (value > 0)
+      continue;
+    if (value < 0) {
+      set_inconsistent (ring, "adopted falsified unit");
+      goto UNLOCK;
+    }
+    assign_ring_unit (ring, unit);
+    units++;
+  }
+  if (units)
+    ring->iterating = -1;
+  if (ring_propagate (ring, false, 0)) {
+    set_inconsistent (ring, "propagation after adopting units failed");
+    goto UNLOCK;
+  }
+  for (unsigned *p = async->binaries.begin; p != async->binaries.end;
+       p += 2) {
+    struct clause *binary = tag_binary (true, p[0], p[1]);
+    if (import_clause (ring, binary) && ring_propagate (ring, false, 0)) {
+      set_inconsistent (ring, "propagation after adopting binary failed");
+      goto UNLOCK;
+    }
+    binaries++;
+  }
+  for (all_clauses (clause, async->clauses)) {
+    reference_clause (ring, clause, 1);
+    if (import_clause (ring, clause) && ring_propagate (ring, false, 0)) {
+      set_inconsistent (ring, "propagation after adopting clause failed");
+      goto UNLOCK;
+    }
+    clauses++;
+  }
+UNLOCK:
+  if (pthread_mutex_unlock (&ruler->locks.async))
+    fatal_error ("failed to release async lock during adoption");
+  very_verbose (ring,
+                "adopted %u units %u binary and %u large clauses "
+                "from asynchronous simplification",
+                units, binaries, clauses);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void apply_asynchronous_clause (struct simplifier *simplifier,
+                                       size_t size, unsigned *literals,
+                                       struct unsigneds *clause) {
+  struct ruler *ruler = simplifier->ruler;
+  signed char *values = (signed char *) ruler->values;
+  CLEAR (*clause);
+  for (size_t i = 0; i != size; i++) {
+    unsigned lit = literals[i];
+    signed char value = values[lit];
+    if (value > 0)
+      return;
+    if (!value)
+      PUSH (*clause, lit);
+  }
+  size = SIZE (*clause);
+  literals = clause->begin;
+  if (!size) {
+    very_verbose (0, "%s", "adopted clause falsified");
+    ruler->inconsistent = true;
+  } else if (size == 1) {
+    ROG ("adopting unit %s", ROGLIT (literals[0]));
+    assign_ruler_unit (ruler, literals[0]);
+  } else if (size == 2) {
+    new_ruler_binary_clause (ruler, literals[0], literals[1]);
+    mark_subsume_literal (simplifier, literals[0]);
+    mark_subsume_literal (simplifier, literals[1]);
+  } else {
+    struct clause *irredundant =
+        new_large_clause (size, literals, false, 0);
+    ROGCLAUSE (irredundant, "adopting");
+    mark_subsume_clause (simplifier, irredundant);
+    PUSH (ruler->clauses, irredundant);
+  }
+}
+
+// The synchronous simplification still runs regularly and is the only
+// place where the shared irredundant clauses are replaced.  Thus before it
+// starts the ruler adopts the last published results as irredundant
+// clauses, i.e., units are assigned, equivalences added as binary clauses
+// which are then substituted, and strengthened clauses added with their
+// literals marked for subsumption, which removes the weaker originals.
+// Variable elimination is left to the synchronous simplification.  As the
+// ruler is compacted afterwards the published results are released.
+
+void apply_asynchronous_simplification (struct simplifier *simplifier) {
+  struct ruler *ruler = simplifier->ruler;
+  struct async *async = &ruler->async;
+  assert (!async->started);
+  if (pthread_mutex_lock (&ruler->locks.async))
+    fatal_error ("failed to acquire async lock during applying");
+#ifndef QUIET
+  size_t units = SIZE (async->units);
+  size_t binaries = SIZE (async->binaries) / 2;
+  size_t clauses = SIZE (async->clauses);
+#endif
+  if (async->inconsistent) {
+    very_verbose (0, "%s", "asynchronous simplification inconsistent");
+    ruler->inconsistent = true;
+  }
+  struct unsigneds clause;
+  INIT (clause);
+  for (unsigned *p = async->units.begin;
+       !ruler->inconsistent && p != async->units.end; p++)
+    apply_asynchronous_clause (simplifier, 1, p, &clause);
+  for (unsigned *p = async->binaries.begin;
+       !ruler->inconsistent && p != async->binaries.end; p += 2)
+    apply_asynchronous_clause (simplifier, 2, p, &clause);
+  for (struct clause **p = async->clauses.begin;
+       !ruler->inconsistent && p != async->clauses.end; p++)
+    apply_asynchronous_clause (simplifier, (*p)->size, (*p)->literals,
+                               &clause);
+  RELEASE (clause);
+  release_published_clauses (async);
+  RELEASE (async->units);
+  RELEASE (async->binaries);
+  async->inconsistent = false;
+  if (pthread_mutex_unlock (&ruler->locks.async))
+    fatal_error ("failed to release async lock during applying");
+  verbose (0,
+           "applied %zu units %zu binary and %zu large clauses "
+           "from asynchronous simplification",
+           units, binaries, clauses);
+}
+
+void stop_asynchronous_simplification (struct ruler *ruler) {
+  struct async *async = &ruler->async;
+  if (!async->started)
+    return;
+  if (pthread_mutex_lock (&ruler->locks.async))
+    fatal_error ("failed to acquire async lock during stopping");
+  if (async->shadow)
+    async->shadow->terminate = true;
+  if (pthread_mutex_unlock (&ruler->locks.async))
+    fatal_error ("failed to release async lock during stopping");
+  join_asynchronous_simplification (ruler);
+}
+
+void release_asynchronous_simplification (struct ruler *ruler) {
+  struct async *async = &ruler->async;
+  stop_asynchronous_simplification (ruler);
+  release_published_clauses (async);
+  RELEASE (async->units);
+  RELEASE (async->binaries);
+}
@@ -0,0 +1,46 @@
+#ifndef _async_h_INCLUDED
+#define _async_h_INCLUDED
+
+#include "clause.h"
+#include "stack.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+struct ring;
+struct ruler;
+struct simplifier;
+
+// With 'simplify_async' enabled the first ring additionally starts an
+// asynchronous simplification halfway between synchronous rounds.  It
+// takes a snapshot of the irredundant clauses (with root-level units
+// already removed) and hands it to a dedicated simplifier thread which
+// runs substitution, deduplication and subsumption on a private shadow
+// ruler while all rings continue searching.  The results (derived units,
+// equivalences and strengthened clauses) are published here.  Every ring
+// imports them as redundant clauses at its next restart, while the ruler
+// applies them to the shared irredundant clauses at the next synchronous
+// simplification (see 'apply_asynchronous_simplification').
+
+struct async {
+  struct ruler *shadow;
+  pthread_t thread;
+  atomic_bool running;
+  bool started;
+  bool inconsistent;
+  atomic_uint_fast64_t published;
+  struct unsigneds units;
+  struct unsigneds binaries;
+  struct clauses clauses;
+};
+
+bool simplifying_asynchronously (struct ring *);
+int start_asynchronous_simplification (struct ring *);
+void adopt_asynchronous_simplification (struct ring *);
+void apply_asynchronous_simplification (struct simplifier *);
+void stop_asynchronous_simplification (struct ruler *);
+void release_asynchronous_simplification (struct ruler *);
+
+#endif
@@ -10,6 +10,9 @@ static void unassign (struct ring *ring, unsigned lit) {
   unsigned not_lit = NOT (lit);
   signed char *values = ring->values;
   values[lit] = values[not_lit] = 0;
+#ifdef PACKED_VALUES
+  unassign_packed_value (ring->packed, lit);
+#endif
   assert (ring->unassigned < ring->size);
   ring->unassigned++;
   unsigned idx = IDX (lit);
@@ -1,9 +1,29 @@
+// Needed for 'syscall' in pedantic C11 mode ('./configure -p').
+
+#define _DEFAULT_SOURCE
+
 #include "message.h"
 #include "ruler.h"
+#include "utilities.h"
 
 #include <inttypes.h>
 #include <string.h>
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PAUSE() _mm_pause ()
+#else
+#define PAUSE() \
+  do { \
+  } while (0)
+#endif
+
 void init_barrier (struct barrier *barrier, const char *name,
                    unsigned size) {
   barrier->name = name;
@@ -13,87 +33,210 @@ void init_barrier (struct barrier *barrier, const char *name,
     return;
   pthread_mutex_init (&barrier->mutex, 0);
   pthread_cond_init (&barrier->condition, 0);
+#ifndef QUIET
+  barrier->first = UINT64_MAX;
+  barrier->waits = allocate_and_clear_array (size, sizeof *barrier->waits);
+#endif
 }
 
-void abort_waiting_and_disable_barrier (struct barrier *barrier) {
+void release_barrier (struct barrier *barrier) {
   if (barrier->size < 2)
     return;
+  pthread_mutex_destroy (&barrier->mutex);
+  pthread_cond_destroy (&barrier->condition);
+#ifndef QUIET
+  free (barrier->waits);
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+
+static void park (struct barrier *barrier, unsigned generation) {
+  atomic_fetch_add (&barrier->parked, 1);
+#ifdef __linux__
+  while (atomic_load (&barrier->generation) == generation &&
+         !atomic_load (&barrier->disabled))
+    syscall (SYS_futex, &barrier->generation, FUTEX_WAIT_PRIVATE,
+             generation, 0, 0, 0);
+#else
   if (pthread_mutex_lock (&barrier->mutex))
     fatal_error ("failed to acquire '%s[%" PRIu64 "]' barrier lock "
-                 "to abort waiting",
+                 "to park",
                  barrier->name, barrier->met);
-  uint64_t met = barrier->met;
-  if (!barrier->disabled) {
-    very_verbose (0, "disabling '%s[%" PRIu64 "]' barrier", barrier->name,
-                  barrier->met);
-    barrier->disabled = true;
-    if (barrier->waiting) {
-      very_verbose (
-          0, "aborting %u waiting threads in '%s[%" PRIu64 "]' barrier",
-          barrier->waiting, barrier->name, barrier->met);
-      barrier->waiting = 0;
-      barrier->met++;
-      pthread_cond_broadcast (&barrier->condition);
-    }
-  }
+  while (atomic_load (&barrier->generation) == generation &&
+         !atomic_load (&barrier->disabled))
+    pthread_cond_wait (&barrier->condition, &barrier->mutex);
+  if (pthread_mutex_unlock (&barrier->mutex))
+    fatal_error ("failed to release '%s[%" PRIu64 "]' barrier lock "
+                 "to park",
+                 barrier->name, barrier->met);
+#endif
+  atomic_fetch_sub (&barrier->parked, 1);
+}
+
+static void wake_up_parked (struct barrier *barrier) {
+  if (!atomic_load (&barrier->parked))
+    return;
+#ifdef __linux__
+  syscall (SYS_futex, &barrier->generation, FUTEX_WAKE_PRIVATE, INT_MAX, 0,
+           0, 0);
+#else
+  if (pthread_mutex_lock (&barrier->mutex))
+    fatal_error ("failed to acquire '%s[%" PRIu64 "]' barrier lock "
+                 "to wake up parked threads",
+                 barrier->name, barrier->met);
+  pthread_cond_broadcast (&barrier->condition);
   if (pthread_mutex_unlock (&barrier->mutex))
     fatal_error ("failed to release '%s[%" PRIu64 "]' barrier lock "
-                 "to abort waiting",
-                 barrier->name, met);
+                 "to wake up parked threads",
+                 barrier->name, barrier->met);
+#endif
+}
+
+static void wait_for_generation (struct barrier *barrier,
+                                 unsigned generation) {
+  for (unsigned spins = 0; spins != BARRIER_SPINS; spins++) {
+    if (atomic_load_explicit (&barrier->generation,
+                              memory_order_acquire) != generation)
+      return;
+    if (atomic_load_explicit (&barrier->disabled, memory_order_relaxed))
+      return;
+    PAUSE ();
+  }
+  park (barrier, generation);
+}
+
+/*------------------------------------------------------------------------*/
+
+void abort_waiting_and_disable_barrier (struct barrier *barrier) {
+  if (barrier->size < 2)
+    return;
+  if (atomic_exchange (&barrier->disabled, true))
+    return;
+  very_verbose (0, "disabling '%s[%" PRIu64 "]' barrier", barrier->name,
+                barrier->met);
+  unsigned waiting = atomic_load (&barrier->waiting);
+  if (waiting)
+    very_verbose (0,
+                  "aborting %u waiting threads in '%s[%" PRIu64 "]' barrier",
+                  waiting, barrier->name, barrier->met);
+  atomic_fetch_add (&barrier->generation, 1);
+  wake_up_parked (barrier);
+}
+
+#ifndef QUIET
+
+static uint64_t arrival_time (void) {
+  return 1e6 * current_time ();
+}
+
+static void record_arrival (struct barrier *barrier, uint64_t arrived) {
+  uint64_t first = atomic_load (&barrier->first);
+  while (arrived < first &&
+         !atomic_compare_exchange_weak (&barrier->first, &first, arrived))
+    ;
+}
+
+static void record_skew (struct barrier *barrier, struct ring *ring,
+                         uint64_t arrived) {
+  uint64_t first = atomic_load (&barrier->first);
+  assert (first <= arrived);
+  double skew = (arrived - first) * 1e-6;
+  barrier->skew += skew;
+  if (skew > barrier->max_skew)
+    barrier->max_skew = skew;
+  barrier->waits[ring->id].last++;
+  atomic_store (&barrier->first, UINT64_MAX);
 }
 
+#endif
+
 bool rendezvous (struct barrier *barrier, struct ring *ring,
                  bool expected_enabled) {
   if (barrier->size < 2)
     return true;
-#ifndef NFASTPATH
-  if (barrier->disabled)
+  if (atomic_load (&barrier->disabled))
     return false;
+
+#ifndef QUIET
+  uint64_t arrived = 0;
+  if (verbosity >= 0) {
+    arrived = arrival_time ();
+    record_arrival (barrier, arrived);
+  }
 #endif
-  if (pthread_mutex_lock (&barrier->mutex))
-    fatal_error ("failed to acquire '%s[%" PRIu64 "]' barrier lock "
-                 "during rendezvous of 'ring[%u}'",
-                 barrier->name, barrier->met, ring->id);
 
+  unsigned generation = atomic_load (&barrier->generation);
   uint64_t met = barrier->met;
-  bool res;
-
-  if (barrier->disabled)
-    res = false;
-  else {
-    assert (barrier->waiting < barrier->size);
-    barrier->waiting++;
-
-    very_verbose (ring, "entered '%s[%" PRIu64 "]' barrier (%u waiting)",
-                  barrier->name, met, barrier->waiting);
+  unsigned waiting = atomic_fetch_add (&barrier->waiting, 1) + 1;
+  assert (waiting <= barrier->size);
 
-    if (barrier->waiting == barrier->size) {
-      barrier->met++;
-      barrier->waiting = 0;
-      pthread_cond_broadcast (&barrier->condition);
-    } else
-      while (!barrier->disabled && met == barrier->met)
-        pthread_cond_wait (&barrier->condition, &barrier->mutex);
+  very_verbose (ring, "entered '%s[%" PRIu64 "]' barrier (%u waiting)",
+                barrier->name, met, waiting);
 
-    barrier->left++;
-    very_verbose (ring, "leaving '%s[%" PRIu64 "]' barrier (%u left)",
-                  barrier->name, met, barrier->left);
+  if (waiting == barrier->size) {
+#ifndef QUIET
+    if (verbosity >= 0)
+      record_skew (barrier, ring, arrived);
+#endif
+    atomic_store (&barrier->waiting, 0);
+    barrier->met++;
+    // Sequentially consistent on purpose.  Parking threads increment
+    // 'parked' before reading 'generation' and here 'generation' is stored
+    // before reading 'parked'.  With release ordering only both loads
+    // could see the old values and a parked thread would never be woken.
+    atomic_store (&barrier->generation, generation + 1);
+    wake_up_parked (barrier);
+  } else
+    wait_for_generation (barrier, generation);
 
-    if (barrier->left == barrier->size)
-      barrier->left = 0;
+#ifndef QUIET
+  if (verbosity >= 0)
+    barrier->waits[ring->id].time += (arrival_time () - arrived) * 1e-6;
+#endif
 
-    res = !barrier->disabled;
-  }
+  bool res = !atomic_load (&barrier->disabled);
 
-  if (pthread_mutex_unlock (&barrier->mutex))
-    fatal_error ("failed to release '%s[%" PRIu64 "]' barrier lock "
-                 "during rendezvous of 'ring[%u}'",
-                 barrier->name, met, ring->id);
+  very_verbose (ring, "leaving '%s[%" PRIu64 "]' barrier", barrier->name,
+                met);
 
   if (expected_enabled && !res)
     fatal_error ("unexpected disabled '%s[%" PRIu64 "]' barrier "
                  "(%u waiting) in rendezvous of 'ring[%u]'",
-                 barrier->name, met, barrier->waiting, ring->id);
+                 barrier->name, met, atomic_load (&barrier->waiting),
+                 ring->id);
 
   return res;
 }
+
+/*------------------------------------------------------------------------*/
+
+#ifndef QUIET
+
+void print_barrier_waits (struct ring *ring, struct barrier *barrier,
+                          double solving) {
+  if (barrier->size < 2)
+    return;
+  struct barrier_waits *waits = barrier->waits + ring->id;
+  PRINTLN ("%10.2f seconds  %5.1f %%  %s barrier (last %" PRIu64
+           " of %" PRIu64 ")",
+           waits->time, percent (waits->time, solving), barrier->name,
+           waits->last, barrier->met);
+}
+
+void print_barrier_skew (struct barrier *barrier, double total) {
+  if (barrier->size < 2)
+    return;
+  struct ring *ring = 0;
+  unsigned slowest = 0;
+  for (unsigned id = 1; id != barrier->size; id++)
+    if (barrier->waits[id].last > barrier->waits[slowest].last)
+      slowest = id;
+  PRINTLN ("%10.2f seconds  %5.1f %%  %s skew "
+           "(%" PRIu64 " met, %.3f max, ring %u last %" PRIu64 ")",
+           barrier->skew, percent (barrier->skew, total), barrier->name,
+           barrier->met, barrier->max_skew, slowest,
+           barrier->waits[slowest].last);
+}
+
+#endif
@@ -2,25 +2,51 @@
 #define _barrier_h_INCLUDED
 
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 
 struct ring;
 struct ruler;
 
+// Threads arriving at a barrier first spin for a short while on the
+// generation counter and only then park (on a futex on Linux and on a
+// condition variable otherwise).  The last arriving thread bumps the
+// generation, which in essence is a sense-reversing barrier.
+
+#define BARRIER_SPINS (1u << 12)
+
+struct barrier_waits {
+  double time;
+  uint64_t last;
+};
+
 struct barrier {
   const char *name;
   pthread_mutex_t mutex;
   pthread_cond_t condition;
-  volatile bool disabled;
-  unsigned waiting;
-  unsigned left;
+  atomic_bool disabled;
+  atomic_uint waiting;
+  atomic_uint generation;
+  atomic_uint parked;
   unsigned size;
   uint64_t met;
+#ifndef QUIET
+  atomic_uint_fast64_t first;
+  double skew;
+  double max_skew;
+  struct barrier_waits *waits;
+#endif
 };
 
 void init_barrier (struct barrier *, const char *name, unsigned size);
+void release_barrier (struct barrier *);
 bool rendezvous (struct barrier *, struct ring *, bool expected_enabled);
 void abort_waiting_and_disable_barrier (struct barrier *);
 
+#ifndef QUIET
+void print_barrier_waits (struct ring *, struct barrier *, double solving);
+void print_barrier_skew (struct barrier *, double total);
+#endif
+
 #endif
@@ -0,0 +1,173 @@
+#!/bin/sh
+
+# Runs a matrix of instances times thread counts times option sets with a
+# number of repetitions and writes one CSV line per run.  The per-ring
+# statistics printed by the solver are summed up (thus verbose output and
+# '--quiet' configurations are not supported).  With a baseline CSV file
+# the average wall-clock time of each configuration is compared to the
+# baseline and configurations which became slower than the threshold are
+# reported as regressions (then the exit code is 1).  Configurations which
+# took less than 0.1 seconds in the baseline are too noisy to compare.  A
+# missing baseline file is created from the results.  The options field is
+# always quoted, since options might contain commas (e.g., '--scaling=1,2').
+
+die () {
+  echo "bench/bench.sh: error: $*" 1>&2
+  exit 1
+}
+
+usage () {
+cat <<EOF
+usage: bench/bench.sh [ <option> ... ] [ <dimacs> ... ]
+
+where '<option>' is one of the following
+
+  -h                 print this command line option summary
+  -r <repetitions>   number of runs per configuration (default '1')
+  -t <threads>       comma separated thread counts (default '1')
+  -o '<options>'     add option set passed to solver (default '')
+  -l <seconds>       time limit per run (default '100')
+  -c <csv>           write results to this file (default 'bench.csv')
+  -b <baseline>      compare against (or create) this baseline CSV file
+  -s <percent>       regression threshold in percent (default '10')
+
+and '<dimacs>' are the benchmark instances (default 'cnf/*.cnf').
+EOF
+}
+
+root=`dirname $0`/..
+solver=$root/gimsatul
+repetitions=1
+threads=1
+nsets=0
+limit=100
+csv=bench.csv
+baseline=""
+threshold=10
+cnfs=""
+
+while [ $# -gt 0 ]
+do
+  case "$1" in
+    -h) usage; exit 0;;
+    -r|-t|-o|-l|-c|-b|-s)
+      [ $# -gt 1 ] || die "argument to '$1' missing"
+      case "$1" in
+	-r) repetitions="$2";;
+	-t) threads="$2";;
+	-o) nsets=`expr $nsets + 1`; eval "set_$nsets=\"\$2\"";;
+	-l) limit="$2";;
+	-c) csv="$2";;
+	-b) baseline="$2";;
+	-s) threshold="$2";;
+      esac
+      shift;;
+    -*) die "invalid option '$1' (try '-h')";;
+    *) [ -f "$1" ] || die "can not find '$1'"; cnfs="$cnfs $1";;
+  esac
+  shift
+done
+
+[ -x $solver ] || die "can not find '$solver' (run 'make' first)"
+[ "$cnfs" ] || cnfs="`ls $root/cnf/*.cnf`"
+[ $nsets = 0 ] && nsets=1 && set_1=""
+
+log=${TMPDIR:-/tmp}/gimsatul-bench-$$.log
+trap "rm -f $log" EXIT
+trap "rm -f $log; exit 1" INT TERM
+
+# Extracts the numbers of one run from the solver output in '$log'.
+
+extract () {
+  awk '
+/^c[0-9]*  *conflicts:/ { conflicts += $3 }
+/^c[0-9]*  *propagations:/ { propagations += $3 }
+/^c[0-9]*  *exported-clauses:/ { exported += $3 }
+/^c[0-9]*  *imported-clauses:/ { imported += $3 }
+/^c[0-9]*  *useful-tier[123]:/ { useful += $3 }
+/^c  *[0-9.]* seconds .*%  simplify$/ { simplify = $2 }
+/^c wall-clock-time:/ { wall = $3 }
+/^c maximum-resident-set-size:/ { rss = $3 }
+END {
+  printf "%.2f,%.0f,%.0f,%.0f,%.0f,%.2f,%.2f,%.0f,%.0f,%.0f\n",
+    wall, conflicts, wall ? conflicts / wall : 0,
+    propagations, wall ? propagations / wall : 0,
+    rss, simplify, exported, imported, useful
+}' $log
+}
+
+echo "instance,threads,options,run,status,wall,conflicts,conflicts_per_second,propagations,propagations_per_second,rss_mb,simplify,exported,imported,useful" > $csv || \
+  die "can not write '$csv'"
+
+for cnf in $cnfs
+do
+  name=`basename $cnf .cnf`
+  for t in `echo $threads | tr , ' '`
+  do
+    i=1
+    while [ $i -le $nsets ]
+    do
+      eval "opts=\"\$set_$i\""
+      quoted=`printf '%s\n' "$opts" | sed -e 's/"/""/g'`
+      r=1
+      while [ $r -le $repetitions ]
+      do
+	cmd="$solver --threads=$t --time=$limit $opts $cnf"
+	echo "$cmd"
+	$cmd > $log 2>&1
+	status=$?
+	echo "$name,$t,\"$quoted\",$r,$status,`extract`" >> $csv
+	r=`expr $r + 1`
+      done
+      i=`expr $i + 1`
+    done
+  done
+done
+
+echo "bench/bench.sh: wrote '$csv'"
+
+[ "$baseline" ] || exit 0
+
+if [ ! -f "$baseline" ]
+then
+  cp $csv $baseline || die "can not write baseline '$baseline'"
+  echo "bench/bench.sh: stored baseline '$baseline'"
+  exit 0
+fi
+
+awk -v threshold=$threshold '
+function split_csv(line, fields,   n, i, c, quoted, field) {
+  n = 0; field = ""; quoted = 0
+  for (i = 1; i <= length (line); i++) {
+    c = substr (line, i, 1)
+    if (quoted) {
+      if (c != "\"") field = field c
+      else if (substr (line, i + 1, 1) == "\"") { field = field c; i++ }
+      else quoted = 0
+    } else if (c == "\"") quoted = 1
+    else if (c == ",") { fields[++n] = field; field = "" }
+    else field = field c
+  }
+  fields[++n] = field
+  return n
+}
+FNR == 1 { next }
+{ split_csv($0, f); key = f[1] "," f[2] "," f[3] }
+NR == FNR { old[key] += f[6]; olds[key]++; next }
+{ new[key] += f[6]; news[key]++ }
+END {
+  res = 0
+  for (key in new) {
+    if (!(key in old))
+      continue
+    a = old[key] / olds[key]
+    b = new[key] / news[key]
+    if (a >= 0.1 && b > a * (1 + threshold / 100)) {
+      printf "bench/bench.sh: regression '\''%s'\'' %.2f -> %.2f seconds (%+.1f%%)\n", key, a, b, 100 * (b - a) / a
+      res = 1
+    }
+  }
+  exit res
+}' $baseline $csv || exit 1
+
+echo "bench/bench.sh: no regressions beyond $threshold% compared to '$baseline'"
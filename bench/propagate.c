@@ -0,0 +1,339 @@
+// Microbenchmark for the propagation kernel 'ring_propagate'.
+//
+// Parses and simplifies a CNF exactly as the solver does, clones the rings
+// and then lets every ring (each in its own thread) assign decisions and
+// propagate them until a conflict or a full assignment, after which it
+// backtracks to the root level.  There is no conflict analysis, no
+// learning, no restarts nor any other search procedure.  Decisions are
+// either picked randomly with a fixed seed (per ring) or replayed from a
+// file with DIMACS literals, where '0' forces backtracking to the root.
+// The random sequence of the first ring can be recorded in that format.
+// Only the time spent in 'ring_propagate' is measured and reported in
+// nanoseconds per propagation together with ticks per propagation.  With
+// '--threads=<n>' all rings propagate concurrently which shows the effect
+// of memory bandwidth contention on the same (shared) clauses.
+
+#include "../assign.h"
+#include "../backtrack.h"
+#include "../clone.h"
+#include "../detach.h"
+#include "../message.h"
+#include "../parse.h"
+#include "../propagate.h"
+#include "../random.h"
+#include "../ruler.h"
+#include "../simplify.h"
+#include "../system.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double now (void) {
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+#define BACKTRACK_LIT (INVALID_LIT - 1)
+
+struct sequence {
+  unsigned *literals;
+  size_t size;
+};
+
+struct benchmark {
+  struct ring *ring;
+  pthread_t thread;
+  pthread_barrier_t *start;
+  struct sequence *replay;
+  FILE *record;
+  const unsigned *unmap;
+  uint64_t limit;
+  uint64_t seed;
+  uint64_t decisions;
+  uint64_t conflicts;
+  uint64_t propagations;
+  uint64_t ticks;
+  double time;
+};
+
+// The rings work on compacted variable indices after simplification, while
+// recorded decisions use the original DIMACS variables.  Literals of
+// eliminated, fixed or out-of-range variables are mapped to 'INVALID_LIT'
+// and '0' to 'BACKTRACK_LIT'.
+
+static struct sequence *read_sequence (const char *path,
+                                       struct ruler *ruler) {
+  FILE *file = fopen (path, "r");
+  if (!file)
+    die ("can not read decision sequence '%s'", path);
+  unsigned *map = malloc (ruler->size * sizeof *map);
+  for (unsigned idx = 0; idx != ruler->size; idx++)
+    map[idx] = INVALID_VAR;
+  for (unsigned idx = 0; idx != ruler->compact; idx++)
+    map[ruler->unmap ? ruler->unmap[idx] : idx] = idx;
+  struct sequence *sequence = calloc (1, sizeof *sequence);
+  size_t capacity = 0;
+  int dimacs;
+  while (fscanf (file, "%d", &dimacs) == 1) {
+    unsigned lit = 0;
+    if (dimacs) {
+      unsigned original = abs (dimacs) - 1;
+      unsigned idx = original < ruler->size ? map[original] : INVALID_VAR;
+      if (idx == INVALID_VAR)
+        lit = INVALID_LIT;
+      else
+        lit = LIT (idx), lit = dimacs < 0 ? NOT (lit) : lit;
+    } else
+      lit = BACKTRACK_LIT;
+    if (sequence->size == capacity) {
+      capacity = capacity ? 2 * capacity : 1024;
+      sequence->literals = realloc (
+          sequence->literals, capacity * sizeof *sequence->literals);
+    }
+    sequence->literals[sequence->size++] = lit;
+  }
+  if (!feof (file))
+    die ("invalid literal in decision sequence '%s'", path);
+  fclose (file);
+  free (map);
+  return sequence;
+}
+
+static void record_literal (struct benchmark *benchmark, unsigned lit) {
+  if (!benchmark->record)
+    return;
+  if (lit == BACKTRACK_LIT)
+    fputs ("0\n", benchmark->record);
+  else {
+    unsigned idx = IDX (lit);
+    int dimacs = (benchmark->unmap ? benchmark->unmap[idx] : idx) + 1;
+    fprintf (benchmark->record, "%d ", SGN (lit) ? -dimacs : dimacs);
+  }
+}
+
+static bool timed_propagate (struct benchmark *benchmark) {
+  struct ring *ring = benchmark->ring;
+  double start = now ();
+  struct watch *conflict = ring_propagate (ring, true, 0);
+  benchmark->time += now () - start;
+  if (!conflict)
+    return true;
+  benchmark->conflicts++;
+  return false;
+}
+
+static void restart_from_root (struct benchmark *benchmark) {
+  struct ring *ring = benchmark->ring;
+  if (ring->level)
+    backtrack (ring, 0);
+  record_literal (benchmark, BACKTRACK_LIT);
+}
+
+static void decide_and_propagate (struct benchmark *benchmark,
+                                  unsigned lit) {
+  struct ring *ring = benchmark->ring;
+  assert (!ring->values[lit]);
+  ring->level++;
+  ring->statistics.contexts[ring->context].decisions++;
+  assign_decision (ring, lit);
+  record_literal (benchmark, lit);
+  benchmark->decisions++;
+  if (!timed_propagate (benchmark) || !ring->unassigned)
+    restart_from_root (benchmark);
+}
+
+static unsigned random_literal (struct ring *ring, uint64_t *random) {
+  signed char *values = ring->values;
+  unsigned idx = random_modulo (random, ring->size);
+  while (values[LIT (idx)])
+    if (++idx == ring->size)
+      idx = 0;
+  unsigned lit = LIT (idx);
+  return random_bit (random) ? NOT (lit) : lit;
+}
+
+static void random_decisions (struct benchmark *benchmark) {
+  struct ring *ring = benchmark->ring;
+  uint64_t random = benchmark->seed;
+  while (benchmark->decisions != benchmark->limit && ring->unassigned)
+    decide_and_propagate (benchmark, random_literal (ring, &random));
+}
+
+static void replay_decisions (struct benchmark *benchmark) {
+  struct ring *ring = benchmark->ring;
+  struct sequence *replay = benchmark->replay;
+  signed char *values = ring->values;
+  uint64_t decided;
+  do {
+    decided = benchmark->decisions;
+    for (size_t i = 0; i != replay->size; i++) {
+      if (benchmark->decisions == benchmark->limit || !ring->unassigned)
+        return;
+      unsigned lit = replay->literals[i];
+      if (lit == BACKTRACK_LIT)
+        restart_from_root (benchmark);
+      else if (lit != INVALID_LIT && !values[lit])
+        decide_and_propagate (benchmark, lit);
+    }
+  } while (decided != benchmark->decisions);
+}
+
+static void *run_benchmark (void *ptr) {
+  struct benchmark *benchmark = ptr;
+  struct ring *ring = benchmark->ring;
+  struct context *context = ring->statistics.contexts + ring->context;
+  uint64_t propagations = context->propagations;
+  uint64_t ticks = context->ticks;
+  pthread_barrier_wait (benchmark->start);
+  if (!ring->inconsistent && timed_propagate (benchmark)) {
+    if (benchmark->replay)
+      replay_decisions (benchmark);
+    else
+      random_decisions (benchmark);
+    if (ring->level)
+      backtrack (ring, 0);
+  }
+  benchmark->propagations = context->propagations - propagations;
+  benchmark->ticks = context->ticks - ticks;
+  return 0;
+}
+
+static void print_benchmark (const char *name, struct benchmark *b) {
+  double propagations = b->propagations;
+  printf ("%-5s %10" PRIu64 " %10" PRIu64 " %12" PRIu64
+          " %8.3f %10.2f %10.2f\n",
+          name, b->decisions, b->conflicts, b->propagations, b->time,
+          propagations ? 1e9 * b->time / propagations : 0,
+          propagations ? b->ticks / propagations : 0);
+}
+
+static const char *match (const char *opt, const char *name) {
+  size_t len = strlen (name);
+  if (strncmp (opt, name, len) || opt[len] != '=')
+    return 0;
+  return opt + len + 1;
+}
+
+int main (int argc, char **argv) {
+  uint64_t limit = 1000000, seed = 42;
+  const char *replay_path = 0, *record_path = 0, *arg;
+  char **solver_argv = malloc ((argc + 1) * sizeof *solver_argv);
+  int solver_argc = 0;
+  solver_argv[solver_argc++] = argv[0];
+  for (int i = 1; i != argc; i++) {
+    const char *opt = argv[i];
+    if (!strcmp (opt, "-h") || !strcmp (opt, "--help")) {
+      printf ("usage: propagate [ <option> ... ] <dimacs>\n"
+              "\n"
+              "where '<option>' is one of the following\n"
+              "\n"
+              "  --decisions=<n>   decisions per ring (default '%" PRIu64
+              "')\n"
+              "  --seed=<n>        random seed (default '%" PRIu64 "')\n"
+              "  --replay=<file>   replay decisions in DIMACS format\n"
+              "  --record=<file>   record random decisions of ring 0\n"
+              "\n"
+              "or any solver option, in particular '--threads=<n>'.\n",
+              limit, seed);
+      return 0;
+    } else if ((arg = match (opt, "--decisions"))) {
+      if (sscanf (arg, "%" SCNu64, &limit) != 1 || !limit)
+        die ("invalid option '%s'", opt);
+    } else if ((arg = match (opt, "--seed"))) {
+      if (sscanf (arg, "%" SCNu64, &seed) != 1)
+        die ("invalid option '%s'", opt);
+    } else if ((arg = match (opt, "--replay")))
+      replay_path = arg;
+    else if ((arg = match (opt, "--record")))
+      record_path = arg;
+    else
+      solver_argv[solver_argc++] = argv[i];
+  }
+  solver_argv[solver_argc] = 0;
+  if (replay_path && record_path)
+    die ("can not combine '--replay' and '--record'");
+
+  start_time = current_time ();
+#ifndef QUIET
+  verbosity = -1;
+#endif
+  struct options options;
+  parse_options (solver_argc, solver_argv, &options);
+  free (solver_argv);
+  int variables, clauses;
+  parse_dimacs_header (&options, &variables, &clauses);
+  struct ruler *ruler = new_ruler (variables, &options);
+  parse_dimacs_body (ruler, variables, clauses);
+  simplify_ruler (ruler);
+  clone_rings (ruler);
+
+  struct sequence *replay = 0;
+  if (replay_path)
+    replay = read_sequence (replay_path, ruler);
+  FILE *record = 0;
+  if (record_path && !(record = fopen (record_path, "w")))
+    die ("can not write decision sequence '%s'", record_path);
+
+  size_t size = SIZE (ruler->rings);
+  struct benchmark *benchmarks = calloc (size, sizeof *benchmarks);
+  pthread_barrier_t start;
+  pthread_barrier_init (&start, 0, size);
+  for (all_rings (ring)) {
+    struct benchmark *benchmark = benchmarks + ring->id;
+    benchmark->ring = ring;
+    benchmark->start = &start;
+    benchmark->replay = replay;
+    benchmark->record = ring->id ? 0 : record;
+    benchmark->unmap = ruler->unmap;
+    benchmark->limit = limit;
+    benchmark->seed = seed + ring->id;
+  }
+  double wall = now ();
+  for (size_t i = 0; i != size; i++)
+    if (pthread_create (&benchmarks[i].thread, 0, run_benchmark,
+                        benchmarks + i))
+      die ("failed to create benchmark thread");
+  for (size_t i = 0; i != size; i++)
+    if (pthread_join (benchmarks[i].thread, 0))
+      die ("failed to join benchmark thread");
+  wall = now () - wall;
+  pthread_barrier_destroy (&start);
+
+  printf ("%u variables, %zu rings, %s decisions\n", ruler->compact, size,
+          replay ? "replayed" : "random");
+  printf ("%-5s %10s %10s %12s %8s %10s %10s\n", "ring", "decisions",
+          "conflicts", "propagations", "seconds", "ns/prop", "ticks/prop");
+  struct benchmark total;
+  memset (&total, 0, sizeof total);
+  char name[32];
+  for (size_t i = 0; i != size; i++) {
+    struct benchmark *b = benchmarks + i;
+    snprintf (name, sizeof name, "%zu", i);
+    print_benchmark (name, b);
+    total.decisions += b->decisions;
+    total.conflicts += b->conflicts;
+    total.propagations += b->propagations;
+    total.ticks += b->ticks;
+    total.time += b->time;
+  }
+  if (size > 1)
+    print_benchmark ("all", &total);
+  printf ("%.3f seconds wall-clock time, %.2f million propagations per "
+          "second\n",
+          wall, wall ? 1e-6 * total.propagations / wall : 0);
+
+  if (record)
+    fclose (record);
+  if (replay)
+    free (replay->literals), free (replay);
+  free (benchmarks);
+  detach_and_delete_rings (ruler);
+  delete_ruler (ruler);
+  return 0;
+}
@@ -0,0 +1,127 @@
+// Microbenchmark for the replacement search kernels in 'replace.c'.
+//
+// Generates synthetic long clauses over a random partial assignment, in
+// which most literals are false, and measures the time each supported
+// kernel needs to find replacements in the circular search order used by
+// propagation.  All kernels are checked to return the same results.
+
+#include "../replace.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static unsigned long long state = 42;
+
+static unsigned pick (unsigned mod) {
+  state = state * 6364136223846793005ull + 1442695040888963407ull;
+  return (state >> 32) % mod;
+}
+
+static double now (void) {
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+struct search {
+  unsigned *literals;
+  unsigned size, middle;
+  unsigned not_lit, other;
+};
+
+static unsigned long long run (find_replacement_function *find,
+                               signed char *values, struct search *searches,
+                               unsigned count, unsigned rounds) {
+  unsigned long long sum = 0;
+  for (unsigned round = 0; round != rounds; round++)
+    for (struct search *s = searches; s != searches + count; s++) {
+      unsigned *literals = s->literals;
+      unsigned *middle = literals + s->middle;
+      unsigned *end = literals + s->size;
+      unsigned *r = find (values, middle, end, s->not_lit, s->other);
+      if (r == end) {
+        r = find (values, literals, middle, s->not_lit, s->other);
+        if (r == middle)
+          r = end;
+      }
+      sum += r - literals;
+    }
+  return sum;
+}
+
+int main (int argc, char **argv) {
+  unsigned variables = argc > 1 ? atoi (argv[1]) : 1000000;
+  unsigned count = argc > 2 ? atoi (argv[2]) : 100000;
+  unsigned rounds = argc > 3 ? atoi (argv[3]) : 20;
+  unsigned percent_false = argc > 4 ? atoi (argv[4]) : 95;
+  if (variables < 2 || !count || !rounds || percent_false > 100) {
+    fprintf (stderr,
+             "usage: replace [ <variables> [ <clauses> [ <rounds> "
+             "[ <percent-false> ] ] ] ]\n");
+    return 1;
+  }
+  size_t size = 2 * (size_t) variables;
+  signed char *values = calloc (size + VALUES_PADDING, 1);
+  for (unsigned idx = 0; idx != variables; idx++) {
+    if (pick (100) >= percent_false)
+      continue;
+    unsigned lit = 2 * idx + pick (2);
+    values[lit] = -1;
+    values[lit ^ 1] = 1;
+  }
+  struct search *searches = malloc (count * sizeof *searches);
+  unsigned long long literals = 0;
+  for (struct search *s = searches; s != searches + count; s++) {
+    unsigned clause_size = 20 + pick (181);
+    s->literals = malloc (clause_size * sizeof (unsigned));
+    for (unsigned i = 0; i != clause_size; i++) {
+      unsigned lit = 2 * pick (variables) + pick (2);
+      if (values[lit] > 0 && pick (4))
+        lit ^= 1;
+      s->literals[i] = lit;
+    }
+    s->size = clause_size;
+    s->middle = pick (clause_size);
+    s->not_lit = s->literals[0];
+    s->other = s->literals[1];
+    literals += clause_size;
+  }
+  printf ("%u clauses of average size %.1f over %u variables "
+          "(%u%% false)\n",
+          count, literals / (double) count, variables, percent_false);
+  const struct replacement_kernel *kernels = replacement_kernels;
+  unsigned long long expected = 0;
+  bool first = true;
+  double times[8] = {0}, portable = 0;
+  int res = 0;
+  for (const struct replacement_kernel *k = kernels; k->name; k++) {
+    if (!supported_replacement_kernel (k))
+      continue;
+    double start = now ();
+    unsigned long long sum = run (k->find, values, searches, count, rounds);
+    double time = times[k - kernels] = now () - start;
+    if (first)
+      expected = sum, first = false;
+    else if (sum != expected) {
+      fprintf (stderr, "replace: kernel '%s' result mismatch\n", k->name);
+      res = 1;
+    }
+    if (!k[1].name)
+      portable = time;
+  }
+  for (const struct replacement_kernel *k = kernels; k->name; k++) {
+    if (!supported_replacement_kernel (k))
+      continue;
+    double time = times[k - kernels];
+    printf ("%-10s %8.3f seconds %8.2f ns per search %6.2f speed-up\n",
+            k->name, time, 1e9 * time / ((double) count * rounds),
+            time ? portable / time : 0);
+  }
+  for (struct search *s = searches; s != searches + count; s++)
+    free (s->literals);
+  free (searches);
+  free (values);
+  return res;
+}
@@ -1,4 +1,5 @@
 #include "catch.h"
+#include "json.h"
 #include "message.h"
 #include "ruler.h"
 #include "statistics.h"
@@ -108,13 +109,15 @@ static void catch_signal (int sig) {
   if (atomic_exchange (&caught_signal, sig))
     return;
   caught_message (sig);
-#ifndef QUIET
   struct ruler *ruler = (struct ruler *) one_global_ruler;
-#endif
   reset_signal_handlers ();
+  if (ruler && ruler->monitor.running)
+    (void) unlink (ruler->options.monitor);
 #ifndef QUIET
-  if (ruler)
+  if (ruler) {
+    write_json_statistics (ruler);
     print_ruler_statistics (ruler);
+  }
 #endif
   raising_message (sig);
   raise (sig);
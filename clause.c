@@ -27,7 +27,7 @@ struct clause *new_large_clause (size_t size, unsigned *literals,
   clause->dirty = false;
   clause->garbage = false;
   clause->mapped = false;
-  clause->padding = 0;
+  clause->compressed = false;
   clause->redundant = redundant;
   clause->subsume = false;
   clause->vivified = false;
@@ -39,6 +39,87 @@ struct clause *new_large_clause (size_t size, unsigned *literals,
   return clause;
 }
 
+/*------------------------------------------------------------------------*/
+
+unsigned char *encode_tail_literal (unsigned char *bytes, unsigned delta) {
+  while (delta > 127) {
+    *bytes++ = (delta & 127) | 128;
+    delta >>= 7;
+  }
+  *bytes++ = delta;
+  return bytes;
+}
+
+static size_t bytes_of_delta (unsigned delta) {
+  size_t res = 1;
+  while (delta > 127)
+    delta >>= 7, res++;
+  return res;
+}
+
+static int cmp_literals (const void *p, const void *q) {
+  unsigned a = *(const unsigned *) p, b = *(const unsigned *) q;
+  return (a > b) - (a < b);
+}
+
+// Returns a compressed copy of the given clause and deletes the original
+// one.  The latter is kept if compressing would not save any memory.
+
+struct clause *compress_clause (struct clause *clause) {
+  assert (!clause->compressed);
+  assert (!clause->redundant);
+  assert (!atomic_load (&clause->shared));
+  unsigned size = clause->size;
+  assert (size > COMPRESSED_HEAD_SIZE);
+  unsigned *tail = clause->literals + COMPRESSED_HEAD_SIZE;
+  unsigned *end = clause->literals + size;
+  qsort (tail, end - tail, sizeof *tail, cmp_literals);
+  size_t tail_bytes = 0;
+  unsigned previous = 0;
+  for (unsigned *p = tail; p != end; p++) {
+    unsigned lit = *p;
+    tail_bytes += bytes_of_delta (lit - previous);
+    previous = lit;
+  }
+  size_t head_bytes = COMPRESSED_HEAD_SIZE * sizeof (unsigned);
+  if (head_bytes + tail_bytes >= size * sizeof (unsigned))
+    return clause;
+  struct clause *res =
+      allocate_block (sizeof *res + head_bytes + tail_bytes);
+  memcpy (res, clause, sizeof *res + head_bytes);
+  res->compressed = true;
+  unsigned *compressed = res->literals + COMPRESSED_HEAD_SIZE;
+  unsigned char *bytes = (unsigned char *) compressed;
+  previous = 0;
+  for (unsigned *p = tail; p != end; p++) {
+    unsigned lit = *p;
+    bytes = encode_tail_literal (bytes, lit - previous);
+    previous = lit;
+  }
+  assert (bytes == (unsigned char *) compressed + tail_bytes);
+  free (clause);
+  return res;
+}
+
+size_t bytes_of_clause_literals (struct clause *clause) {
+  size_t res = head_size_of_clause (clause) * sizeof (unsigned);
+  unsigned *tail = clause->literals + COMPRESSED_HEAD_SIZE;
+  unsigned pos = 0, lit = 0;
+  for (unsigned i = tail_size_of_clause (clause); i; i--)
+    lit = decode_tail_literal (tail, &pos, lit);
+  return res + pos;
+}
+
+unsigned *decompress_literals (struct clause *clause,
+                               struct unsigneds *literals) {
+  CLEAR (*literals);
+  for (all_literals_in_clause (lit, clause))
+    PUSH (*literals, lit);
+  return literals->begin;
+}
+
+/*------------------------------------------------------------------------*/
+
 void mark_clause (signed char *marks, struct clause *clause,
                   unsigned except) {
   if (is_binary_pointer (clause))
@@ -61,11 +142,30 @@ void unmark_clause (signed char *marks, struct clause *clause,
 
 void trace_add_clause (struct trace *trace, struct clause *clause) {
   assert (!is_binary_pointer (clause));
-  trace_add_literals (trace, clause->size, clause->literals, INVALID);
+  if (clause->compressed) {
+    if (!trace->file)
+      return;
+    struct unsigneds literals;
+    INIT (literals);
+    decompress_literals (clause, &literals);
+    trace_add_literals (trace, clause->size, literals.begin, INVALID);
+    RELEASE (literals);
+  } else
+    trace_add_literals (trace, clause->size, clause->literals, INVALID);
 }
 
 void trace_delete_clause (struct trace *trace, struct clause *clause) {
-  if (!clause->garbage)
+  if (clause->garbage)
+    return;
+  if (clause->compressed) {
+    if (!trace->file)
+      return;
+    struct unsigneds literals;
+    INIT (literals);
+    decompress_literals (clause, &literals);
+    trace_delete_literals (trace, clause->size, literals.begin);
+    RELEASE (literals);
+  } else
     trace_delete_literals (trace, clause->size, clause->literals);
 }
 
@@ -10,6 +10,7 @@
 #endif
 
 struct ring;
+struct unsigneds;
 
 #define MAX_GLUE 255
 
@@ -18,13 +19,16 @@ struct clause {
   uint64_t id;
 #endif
   atomic_uint shared;
-  unsigned short origin;
+  union {
+    unsigned short origin;   // Exporting ring of shared learned clauses.
+    unsigned short snapshot; // Size of shadow clauses (see 'async.c').
+  };
   atomic_uchar glue;
   bool cleaned : 1;
   bool dirty : 1;
   bool garbage : 1;
   bool mapped : 1;
-  bool padding : 1;
+  bool compressed : 1;
   bool redundant : 1;
   bool subsume : 1;
   bool vivified : 1;
@@ -41,17 +45,63 @@ struct clauses {
 #define all_clauses(ELEM, CLAUSES) \
   all_pointers_on_stack (struct clause, ELEM, CLAUSES)
 
+// Long irredundant clauses can be compressed while cloned into the rings.
+// Then only the first 'COMPRESSED_HEAD_SIZE' literals (which include the
+// two initially watched literals) are kept as they are.  The remaining
+// tail literals are sorted and stored as differences to their predecessor
+// in a variable length byte encoding (seven bits per byte) directly after
+// the head.  The 'size' field still gives the number of literals.
+
+#define COMPRESSED_HEAD_SIZE 4
+
+static inline unsigned head_size_of_clause (struct clause *clause) {
+  return clause->compressed ? COMPRESSED_HEAD_SIZE : clause->size;
+}
+
+static inline unsigned tail_size_of_clause (struct clause *clause) {
+  return clause->compressed ? clause->size - COMPRESSED_HEAD_SIZE : 0;
+}
+
+static inline unsigned decode_tail_literal (const unsigned *tail,
+                                            unsigned *pos,
+                                            unsigned previous) {
+  const unsigned char *bytes = (const unsigned char *) tail;
+  unsigned i = *pos, delta = 0, shift = 0;
+  unsigned char byte;
+  do {
+    byte = bytes[i++];
+    delta |= (unsigned) (byte & 127) << shift;
+    shift += 7;
+  } while (byte & 128);
+  *pos = i;
+  return previous + delta;
+}
+
+#define NEXT_LITERAL_IN_CLAUSE(LIT) \
+  (P_##LIT != END_##LIT && (LIT = *P_##LIT++, true)) || \
+      (TAIL_##LIT && \
+       (TAIL_##LIT--, \
+        LIT = decode_tail_literal (END_##LIT, &POS_##LIT, \
+                                   POS_##LIT ? LIT : 0), \
+        true))
+
 #define all_literals_in_clause(LIT, CLAUSE) \
   unsigned *P_##LIT = (CLAUSE)->literals, \
-           *END_##LIT = P_##LIT + (CLAUSE)->size, LIT; \
-  P_##LIT != END_##LIT && (LIT = *P_##LIT, true); \
-  ++P_##LIT
+           *END_##LIT = P_##LIT + head_size_of_clause (CLAUSE), \
+           TAIL_##LIT = tail_size_of_clause (CLAUSE), POS_##LIT = 0, \
+           LIT = 0; \
+  NEXT_LITERAL_IN_CLAUSE (LIT);
 
 /*------------------------------------------------------------------------*/
 
 struct clause *new_large_clause (size_t, unsigned *, bool redundant,
                                  unsigned glue);
 
+struct clause *compress_clause (struct clause *);
+size_t bytes_of_clause_literals (struct clause *);
+unsigned *decompress_literals (struct clause *, struct unsigneds *);
+unsigned char *encode_tail_literal (unsigned char *, unsigned delta);
+
 void mark_clause (signed char *marks, struct clause *, unsigned except);
 void unmark_clause (signed char *marks, struct clause *, unsigned except);
 
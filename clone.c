@@ -6,19 +6,19 @@
 
 #include <stdio.h>
 
-static void copy_ruler_binaries (struct ring *ring) {
-  struct ruler *ruler = ring->ruler;
+static size_t copy_ruler_binaries_range (struct ring *first,
+                                         unsigned begin, unsigned end) {
+  struct ruler *ruler = first->ruler;
+  struct ring *ring = first;
   assert (!ruler->inconsistent);
-  assert (first_ring (ruler) == ring);
-  assert (!ring->id);
+  assert (!first->id);
   size_t copied = 0;
 
-  for (all_ruler_literals (lit)) {
+  for (unsigned lit = begin; lit != end; lit++) {
     struct clauses *occurrences = &OCCURRENCES (lit);
-    struct references *references = &REFERENCES (lit);
     size_t size = SIZE (*occurrences);
     unsigned *binaries = allocate_array (size + 1, sizeof *binaries);
-    unsigned *b = references->binaries = binaries;
+    unsigned *b = BINARIES (lit) = binaries;
     for (all_clauses (clause, *occurrences)) {
       assert (is_binary_pointer (clause));
       assert (lit_pointer (clause) == lit);
@@ -34,6 +34,13 @@ static void copy_ruler_binaries (struct ring *ring) {
     *b = INVALID;
     RELEASE (*occurrences);
   }
+  return copied;
+}
+
+static void copy_ruler_binaries (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  assert (first_ring (ruler) == ring);
+  size_t copied = copy_ruler_binaries_range (ring, 0, 2 * ruler->compact);
   ring->statistics.irredundant += copied;
   very_verbose (ring, "copied %zu binary clauses", copied);
   assert (copied == ruler->statistics.binaries);
@@ -44,13 +51,7 @@ static void copy_ruler_binaries (struct ring *ring) {
 static void share_ring_binaries (struct ring *dst, struct ring *src) {
   struct ring *ring = dst;
   assert (!src->id);
-
-  for (all_ring_literals (lit)) {
-    struct references *src_references = src->references + lit;
-    struct references *dst_references = dst->references + lit;
-    dst_references->binaries = src_references->binaries;
-  }
-
+  assert (dst->binaries == src->binaries);
   size_t shared = src->ruler->statistics.binaries;
   ring->statistics.irredundant += shared;
   very_verbose (ring, "shared %zu binary clauses", shared);
@@ -127,7 +128,7 @@ void copy_ruler (struct ring *ring) {
   if (ruler->inconsistent) {
     set_inconsistent (ring, "copied empty clause");
     for (all_clauses (clause, ruler->clauses))
-      free (clause);
+      (void) dereference_ruler_clause (ruler, clause);
   } else if (ruler->terminate) {
     return;
   } else {
@@ -143,12 +144,13 @@ static void clone_ruler (struct ruler *src) {
     fflush (stdout);
   }
   struct ring *dst = new_ring (src);
+  compress_ruler_clauses (src);
   copy_ruler (dst);
 }
 
 /*------------------------------------------------------------------------*/
 
-static void clone_clauses (struct ring *ring) {
+static void clone_clauses (struct ring *ring, bool referenced) {
   struct ruler *ruler = ring->ruler;
   assert (!ruler->inconsistent);
 #ifndef QUIET
@@ -156,7 +158,8 @@ static void clone_clauses (struct ring *ring) {
 #endif
   for (all_clauses (clause, ruler->clauses)) {
     assert (!clause->redundant);
-    reference_clause (ring, clause, 1);
+    if (!referenced)
+      reference_clause (ring, clause, 1);
     (void) watch_first_two_literals_in_large_clause (ring, clause);
 #ifndef QUIET
     shared++;
@@ -165,7 +168,7 @@ static void clone_clauses (struct ring *ring) {
   very_verbose (ring, "sharing %zu large clauses", shared);
 }
 
-void copy_ring (struct ring *dst) {
+static void share_ruler_clauses (struct ring *dst, bool referenced) {
   struct ruler *ruler = dst->ruler;
   assert (!ruler->inconsistent);
   struct ring *src = first_ring (ruler);
@@ -173,10 +176,63 @@ void copy_ring (struct ring *dst) {
   assert (!src->id);
   assert (src->ruler == ruler);
   share_ring_binaries (dst, src);
-  clone_clauses (dst);
+  clone_clauses (dst, referenced);
   restore_saved_redundant_clauses (dst);
 }
 
+void copy_ring (struct ring *dst) { share_ruler_clauses (dst, false); }
+
+// After synchronized simplification the flat binary clause arrays of the
+// first ring, which are shared by all rings, are built in parallel.  Each
+// ring copies the occurrence lists of its own slice of literals and takes
+// the references of all other rings to its own slice of large clauses at
+// once.  Otherwise every ring would atomically increment the reference
+// counter of every large clause while attaching, all in the same order.
+// After the next barrier all rings attach concurrently to the simplified
+// clauses of the ruler.  Only watching the large clauses remains per ring,
+// since watches and watchers are ring local.
+
+void copy_ruler_slice (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct ring *first = first_ring (ruler);
+  size_t literals = 2 * (size_t) ruler->compact;
+  size_t rings = SIZE (ruler->rings);
+  unsigned begin = literals * ring->id / rings;
+  unsigned end = literals * (ring->id + 1) / rings;
+#ifndef QUIET
+  size_t copied =
+#endif
+      copy_ruler_binaries_range (first, begin, end);
+  very_verbose (ring, "copied %zu binary clauses of literals %u to %u",
+                copied, begin, end);
+  if (rings == 1)
+    return;
+  size_t clauses = SIZE (ruler->clauses);
+  struct clause **clause = ruler->clauses.begin;
+  struct clause **clauses_begin = clause + clauses * ring->id / rings;
+  struct clause **clauses_end = clause + clauses * (ring->id + 1) / rings;
+  for (clause = clauses_begin; clause != clauses_end; clause++)
+    reference_clause (ring, *clause, rings - 1);
+  very_verbose (ring, "referenced %zu large clauses %zu times",
+                (size_t) (clauses_end - clauses_begin), rings - 1);
+}
+
+void attach_ring (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  if (ring->id) {
+    share_ruler_clauses (ring, true);
+    return;
+  }
+  assert (!ruler->inconsistent);
+  size_t binaries = ruler->statistics.binaries;
+  ring->statistics.irredundant += binaries;
+  very_verbose (ring, "copied %zu binary clauses", binaries);
+  free (ruler->occurrences);
+  ruler->occurrences = 0;
+  transfer_ruler_clauses_to_ring (ring);
+  restore_saved_redundant_clauses (ring);
+}
+
 static void *clone_ring (void *ptr) {
   struct ring *src = ptr;
   struct ring *dst = new_ring (src->ruler);
@@ -231,6 +287,9 @@ void clone_rings (struct ruler *ruler) {
     double after = current_resident_set_size () / (double) (1 << 20);
     printf ("c memory increased by %.2f from %.2f MB to %.2f MB\n",
             average (after, before), before, after);
+    printf ("c rings use %.2f bytes per variable each and share %zu bytes "
+            "per variable\n",
+            ring_bytes_per_variable (), 2 * sizeof *ruler->binaries);
     fflush (stdout);
   }
   STOP (ruler, clone);
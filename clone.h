@@ -5,6 +5,8 @@ struct ring;
 struct ruler;
 void copy_ring (struct ring *dst);
 void copy_ruler (struct ring *dst);
+void copy_ruler_slice (struct ring *);
+void attach_ring (struct ring *);
 void clone_rings (struct ruler *);
 
 #endif
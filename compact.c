@@ -42,9 +42,38 @@ static void map_occurrences (struct ruler *ruler, unsigned *map,
   dst_occurrences->end = q;
 }
 
+// Compacting maps variables monotonically to smaller indices and thus
+// the differences between sorted tail literals of compressed clauses can
+// only become smaller.  Accordingly the tail can be encoded in place.
+
+static void map_compressed_clause (unsigned *map, struct clause *clause) {
+  unsigned *literals = clause->literals;
+  unsigned *tail = literals + COMPRESSED_HEAD_SIZE;
+  for (unsigned *p = literals; p != tail; p++)
+    *p = map_literal (map, *p);
+  unsigned char *bytes = (unsigned char *) tail;
+  unsigned pos = 0, src = 0, dst = 0;
+  for (unsigned i = tail_size_of_clause (clause); i; i--) {
+    unsigned prev = src;
+    src = decode_tail_literal (tail, &pos, src);
+    unsigned mapped = map_literal (map, src);
+    assert (mapped != INVALID);
+    assert (mapped >= dst);
+    assert (mapped - dst <= src - prev);
+    (void) prev;
+    bytes = encode_tail_literal (bytes, mapped - dst);
+    assert (bytes <= (unsigned char *) tail + pos);
+    dst = mapped;
+  }
+}
+
 static void map_large_clause (unsigned *map, struct clause *clause) {
   assert (!is_binary_pointer (clause));
   assert (!clause->redundant);
+  if (clause->compressed) {
+    map_compressed_clause (map, clause);
+    return;
+  }
   unsigned *literals = clause->literals;
   unsigned *end = literals + clause->size;
   for (unsigned *p = literals; p != end; p++)
@@ -146,6 +175,7 @@ static void clean_ring (struct ring *ring, struct clauses *cleaned) {
             new_glue = new_size - 1;
             clause->glue = new_glue;
           }
+          assert (!clause->compressed);
           memcpy (clause->literals, add.begin,
                   new_size * sizeof (unsigned));
           clause->size = new_size;
@@ -183,8 +213,8 @@ static void clean_rings (struct ruler *ruler) {
 static void compact_phases (struct ring *ring, unsigned old_size,
                             unsigned new_size, unsigned *map) {
   struct phases *old_phases = ring->phases;
-  struct phases *new_phases = ring->phases =
-      allocate_array (new_size, sizeof *new_phases);
+  struct phases *new_phases = ring->phases = allocate_and_clear_huge_array (
+      ring->options.huge_pages, new_size, sizeof *new_phases);
   struct phases *old_phase = old_phases;
   struct phases *new_phase = new_phases;
   unsigned *end = map + old_size;
@@ -204,8 +234,8 @@ static void compact_heap (struct ring *ring, struct heap *heap,
                           unsigned old_size, unsigned new_size,
                           unsigned *map) {
   struct node *old_nodes = heap->nodes;
-  struct node *new_nodes = heap->nodes =
-      allocate_and_clear_array (new_size, sizeof *new_nodes);
+  struct node *new_nodes = heap->nodes = allocate_and_clear_huge_array (
+      ring->options.huge_pages, new_size, sizeof *new_nodes);
   heap->root = 0;
   struct node *new_node = new_nodes, *old_node = old_nodes;
   unsigned *end = map + old_size;
@@ -227,8 +257,8 @@ static void compact_queue (struct ring *ring, struct queue *queue,
                            unsigned old_size, unsigned new_size,
                            unsigned *map) {
   struct link *old_links = queue->links;
-  struct link *new_links = queue->links =
-      allocate_and_clear_array (new_size, sizeof *new_links);
+  struct link *new_links = queue->links = allocate_and_clear_huge_array (
+      ring->options.huge_pages, new_size, sizeof *new_links);
   struct link *first = queue->first;
   queue->first = queue->last = 0;
   queue->stamp = 0;
@@ -304,6 +334,7 @@ static void compact_saved (struct ring *ring, unsigned *map,
       if (dst_clause) {
         LOGCLAUSE (src_clause, "mapping");
         assert (src_clause == dst_clause);
+        assert (!dst_clause->compressed);
         unsigned *literals = dst_clause->literals;
         unsigned *end = literals + dst_clause->size;
 #ifdef LOGGING
@@ -365,7 +396,6 @@ static void compact_ring (struct ring *ring, unsigned *map,
   ring->best = 0;
   assert (ring->context == SEARCH_CONTEXT);
   assert (!ring->level);
-  ring->probe = ring->id * (new_size / SIZE (ruler->rings));
   ring->size = new_size;
   ring->target = 0;
   ring->unassigned = new_size;
@@ -508,6 +538,7 @@ void compact_ruler (struct simplifier *simplifier, bool initially) {
   }
   assert (new_compact == mapped);
   ruler->compact = new_compact;
+  init_probing (&ruler->probing, new_compact);
 
   map_clauses (ruler, map);
 
@@ -518,6 +549,10 @@ void compact_ruler (struct simplifier *simplifier, bool initially) {
   ruler->units.begin = allocate_array (new_compact, sizeof (unsigned));
   ruler->units.propagate = ruler->units.end = ruler->units.begin;
 
+  free (ruler->binaries);
+  ruler->binaries =
+      allocate_and_clear_array (2 * new_compact, sizeof *ruler->binaries);
+
   if (!initially)
     compact_rings (ruler, map);
 
@@ -19,7 +19,7 @@ signed char decide_phase (struct ring *ring, unsigned idx) {
   struct phases *p = ring->phases + idx;
   unsigned target = ring->options.target_phases;
   signed char res = 0;
-  if (ring->options.force_phase) {
+  if (ring->options.force_phase && ring->initial_phases) {
     unsigned phase_idx = ring->ruler->unmap[idx];
     res = initial_phase (ring) * ring->initial_phases[phase_idx];
   }
@@ -29,8 +29,11 @@ signed char decide_phase (struct ring *ring, unsigned idx) {
   if (!res)
     res = p->saved;
   if (!res) {
-    unsigned phase_idx = ring->ruler->unmap[idx];
-    res = initial_phase (ring) * ring->initial_phases[phase_idx];
+    res = initial_phase (ring);
+    if (ring->initial_phases) {
+      unsigned phase_idx = ring->ruler->unmap[idx];
+      res *= ring->initial_phases[phase_idx];
+    }
   }
   return res;
 }
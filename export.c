@@ -2,6 +2,7 @@
 #include "message.h"
 #include "random.h"
 #include "ruler.h"
+#include "system.h"
 #include "utilities.h"
 
 #define LD_MAX_VAR 30u
@@ -64,11 +65,15 @@ static struct rings *export_rings (struct ring *ring) {
 
 static void export_to_ring (struct ring *ring, struct ring *other,
                             struct clause *clause, unsigned glue,
-                            unsigned size, uint64_t redundancy) {
+                            unsigned size, uint64_t redundancy,
+                            double exported) {
   LOG ("trying to export to target ring %u with redundancy [%u:%u]",
        other->id, LOG_REDUNDANCY (redundancy));
   assert (ring != other);
 
+  if (other->walker) // Only walks on irredundant clauses.
+    return;
+
   struct pool *pool = ring->pool + other->id;
 
   struct bucket *start = pool->bucket;
@@ -108,6 +113,7 @@ static void export_to_ring (struct ring *ring, struct ring *other,
   if (!is_binary_pointer (clause))
     reference_clause (ring, clause, 1);
 
+  worst->exported = exported;
   atomic_uintptr_t *share = &worst->shared;
   uintptr_t ptr = atomic_exchange (share, (uintptr_t) clause);
   worst->redundancy = redundancy;
@@ -205,8 +211,13 @@ void export_clause (struct ring *ring, struct clause *clause, bool export_to_mal
   uint64_t low = share_by_size ? glue : size;
   uint64_t redundancy = (high << 32) + low;
   struct rings *exports = export_rings (ring);
+#ifndef QUIET
+  double exported = current_time ();
+#else
+  double exported = 0;
+#endif
   for (all_pointers_on_stack (struct ring, other, *exports)) {
-    export_to_ring (ring, other, clause, glue, size, redundancy);
+    export_to_ring (ring, other, clause, glue, size, redundancy, exported);
   }
   
   // export to Mallob
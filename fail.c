@@ -14,6 +14,20 @@
 
 #include <inttypes.h>
 
+void init_probing (struct probing *probing, unsigned size) {
+  release_probing (probing);
+  atomic_init (&probing->cursor, 0);
+  probing->stamps =
+      allocate_and_clear_array (2 * (size_t) size, sizeof *probing->stamps);
+  probing->size = size;
+}
+
+void release_probing (struct probing *probing) {
+  free (probing->stamps);
+  probing->stamps = 0;
+  probing->size = 0;
+}
+
 void failed_literal_probing (struct ring *ring) {
   if (ring->inconsistent)
     return;
@@ -32,33 +46,48 @@ void failed_literal_probing (struct ring *ring) {
   uint64_t limit = probing_ticks_before + delta_probing_ticks;
   signed char *values = ring->values;
   bool *inactive = ring->inactive;
-  unsigned start = INVALID;
-  unsigned max_lit = 2 * ring->size;
-  unsigned probe = ring->probe;
-  if (probe >= max_lit)
-    probe = 0;
+  unsigned variables = ring->size;
+  unsigned max_lit = 2 * variables;
+  struct probing *probing = &ring->ruler->probing;
+  assert (probing->size == variables);
+  atomic_uint *probed_in_round = probing->stamps;
+  unsigned probe = INVALID, round = 0;
   unsigned failed = 0, lifted = 0, probed = 0, last = INVALID;
   unsigned *stamps = allocate_and_clear_array (max_lit, sizeof *stamps);
+  struct ring_statistics *statistics = &ring->statistics;
+  uint64_t claimed = 0;
   struct unsigneds lift;
   INIT (lift);
   while (PROBING_TICKS <= limit) {
     assert (!ring->inconsistent);
-    while (probe != start &&
-           (inactive[IDX (probe)] || stamps[probe] == failed + 1)) {
-      if (start == INVALID)
-        start = probe;
-      if (++probe == max_lit)
-        probe = 0;
-    }
-    if (!probed)
-      very_verbose (ring, "failed literal probing starts at literal %d",
-                    unmap_and_export_literal (ring->ruler->unmap, probe));
     if (terminate_ring (ring))
       break;
-    if (probe == start)
-      break;
-    if (start == INVALID)
-      start = probe;
+    if (probe == INVALID || (probe & 1)) {
+      if (claimed == variables)
+        break;
+      uint64_t position = atomic_fetch_add_explicit (
+          &probing->cursor, 1, memory_order_relaxed);
+      unsigned idx = position % variables;
+      round = position / variables + 1;
+      if (!idx)
+        statistics->probes.rounds++;
+      if (!claimed++)
+        very_verbose (ring,
+                      "failed literal probing starts at literal %d "
+                      "in round %u",
+                      unmap_and_export_literal (ring->ruler->unmap,
+                                                LIT (idx)),
+                      round);
+      probe = LIT (idx);
+    } else
+      probe++;
+    if (inactive[IDX (probe)])
+      continue;
+    if (stamps[probe] == failed + 1)
+      continue;
+    if (atomic_load_explicit (probed_in_round + probe,
+                              memory_order_relaxed) == round)
+      continue;
     if (import_shared (ring)) {
       if (ring->inconsistent)
         break;
@@ -78,6 +107,10 @@ void failed_literal_probing (struct ring *ring) {
     assert (!ring->level);
     ring->level = 1;
     probed++;
+    statistics->probes.probed++;
+    if (atomic_exchange_explicit (probed_in_round + probe, round,
+                                  memory_order_relaxed) != round)
+      statistics->probes.unique++;
     LOG ("probing literal %s", LOGLIT (probe));
     assign_decision (ring, probe);
     struct ring_trail *trail = &ring->trail;
@@ -101,8 +134,12 @@ void failed_literal_probing (struct ring *ring) {
         LOG ("stamping %zu literals not to be probed", end - saved);
         assert (failed < UINT_MAX);
         unsigned stamp = failed + 1;
-        for (unsigned *p = saved; p != end; p++)
-          stamps[*p] = stamp;
+        for (unsigned *p = saved; p != end; p++) {
+          unsigned lit = *p;
+          stamps[lit] = stamp;
+          atomic_store_explicit (probed_in_round + lit, round,
+                                 memory_order_relaxed);
+        }
         if (!(probe & 1)) {
           CLEAR (lift);
           assert (saved < end);
@@ -172,20 +209,16 @@ void failed_literal_probing (struct ring *ring) {
       ring->iterating = -1;
     }
     last = probe;
-    if (++probe == max_lit)
-      probe = 0;
     if (ring->iterating)
       iterate (ring);
   }
   RELEASE (lift);
   free (stamps);
   very_verbose (ring,
-                "failed literal probing ends at literal %d after %" PRIu64
-                " ticks (%s)",
-                unmap_and_export_literal (ring->ruler->unmap, probe),
-                PROBING_TICKS - probing_ticks_before,
+                "failed literal probing claimed %" PRIu64
+                " variables in round %u after %" PRIu64 " ticks (%s)",
+                claimed, round, PROBING_TICKS - probing_ticks_before,
                 (PROBING_TICKS > limit ? "limit hit" : "completed"));
-  ring->probe = probe;
   verbose (ring,
            "probed %u literals %.0f%% and "
            "found %u failed literals %.0f%% lifted %u",
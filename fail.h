@@ -1,8 +1,28 @@
 #ifndef _failed_h_INCLUDED
 #define _failed_h_INCLUDED
 
+#include <stdatomic.h>
+#include <stdint.h>
+
 struct ring;
 
+// Failed literal probing is coordinated among all rings through a shared
+// cursor over the variables of the ruler.  Each ring claims the next
+// variable by atomically incrementing the cursor and then probes both of
+// its literals.  The cursor only grows and thus its value divided by the
+// number of variables gives the current probing round.  Literals probed
+// (or implied by a successful probe) during a round are stamped with the
+// round number and then skipped by all other rings during that round.
+
+struct probing {
+  atomic_uint_fast64_t cursor;
+  atomic_uint *stamps;
+  unsigned size;
+};
+
+void init_probing (struct probing *, unsigned size);
+void release_probing (struct probing *);
+
 void failed_literal_probing (struct ring *);
 
 #endif
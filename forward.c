@@ -0,0 +1,72 @@
+#include "forward.h"
+#include "message.h"
+#include "ring.h"
+#include "utilities.h"
+
+#include <inttypes.h>
+
+void install_forwarding (struct ring *ring, unsigned start, unsigned *map) {
+  struct forward *forward = &ring->forward;
+  assert (!forward->map);
+  forward->map = map;
+  forward->start = start;
+  forward->epoch++;
+  very_verbose (ring, "forwarding watcher indices from %u in epoch %u",
+                start, forward->epoch);
+}
+
+void forward_references (struct ring *ring, unsigned lit) {
+  struct forward *forward = &ring->forward;
+  assert (forward->epochs[lit] + 1 == forward->epoch);
+  forward->epochs[lit] = forward->epoch;
+  unsigned *map = forward->map;
+  assert (map);
+  unsigned start = forward->start;
+  struct references *watches = &REFERENCES (lit);
+  struct watch **begin = watches->begin, **q = begin;
+  struct watch **end = watches->end;
+  for (struct watch **p = begin; p != end; p++) {
+    struct watch *watch = *p;
+    if (!is_binary_pointer (watch)) {
+      unsigned src = index_pointer (watch);
+      if (src >= start) {
+        unsigned dst = map[src - start];
+        if (!dst)
+          continue;
+        bool redundant = redundant_pointer (watch);
+        unsigned other = other_pointer (watch);
+        watch = tag_index (redundant, dst, other);
+      }
+    }
+    *q++ = watch;
+  }
+  watches->end = q;
+  SHRINK_STACK (*watches);
+  ring->statistics.forwarded.lazily++;
+}
+
+void forward_all_references (struct ring *ring) {
+  struct forward *forward = &ring->forward;
+  if (!forward->map)
+    return;
+  struct ring_statistics *statistics = &ring->statistics;
+  uint64_t lazily = statistics->forwarded.lazily;
+  for (all_ring_literals (lit))
+    forward_watches (ring, lit);
+  uint64_t eagerly = statistics->forwarded.lazily - lazily;
+  statistics->forwarded.lazily = lazily;
+  statistics->forwarded.eagerly += eagerly;
+  very_verbose (ring, "forwarded %" PRIu64 " remaining watch lists",
+                eagerly);
+  free (forward->map);
+  forward->map = 0;
+}
+
+void release_forwarding (struct ring *ring) {
+  struct forward *forward = &ring->forward;
+  free (forward->map);
+  free (forward->epochs);
+  forward->map = 0;
+  forward->epochs = 0;
+  forward->epoch = 0;
+}
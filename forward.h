@@ -0,0 +1,31 @@
+#ifndef _forward_h_INCLUDED
+#define _forward_h_INCLUDED
+
+#include <stdbool.h>
+
+struct ring;
+
+// Flushing garbage watchers during reduction moves the remaining watchers
+// and thus changes the watcher indices stored in watches.  Instead of
+// rewriting the watch lists of all literals eagerly after the reduction,
+// the map from old to new watcher indices is kept as forwarding table and
+// the epoch is incremented.  The watch list of a literal is only rewritten
+// through the forwarding table when it is accessed the next time (during
+// propagation, before a watch is pushed or during subsumption checks of
+// imported clauses), which is detected by comparing its epoch with the
+// current one.  Before the next reduction installs a new forwarding table
+// all remaining stale watch lists are forwarded.
+
+struct forward {
+  unsigned epoch;
+  unsigned start;
+  unsigned *map;
+  unsigned *epochs;
+};
+
+void install_forwarding (struct ring *, unsigned start, unsigned *map);
+void forward_references (struct ring *, unsigned lit);
+void forward_all_references (struct ring *);
+void release_forwarding (struct ring *);
+
+#endif
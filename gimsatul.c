@@ -2,9 +2,13 @@
 #include "catch.h"
 #include "clone.h"
 #include "detach.h"
+#include "import.h"
+#include "json.h"
 #include "message.h"
 #include "parse.h"
+#include "perf.h"
 #include "ruler.h"
+#include "scaling.h"
 #include "simplify.h"
 #include "solve.h"
 #include "statistics.h"
@@ -20,6 +24,11 @@ int main (int argc, char **argv) {
   parse_options (argc, argv, &options);
   print_banner ();
   check_types ();
+#ifndef QUIET
+  init_perf_counters (&options);
+  if (options.scalings)
+    return scaling_benchmark (&options);
+#endif
   if (verbosity >= 0 && options.proof.file) {
     printf ("c\nc writing %s proof trace to '%s'\n",
             options.binary ? "binary" : "ASCII", options.proof.path);
@@ -53,6 +62,10 @@ int main (int argc, char **argv) {
     fflush (stdout);
     free (witness);
   }
+#ifndef QUIET
+  retire_imported_watchers (ruler);
+  write_json_statistics (ruler);
+#endif
   if (options.summarize)
     summarize_used_resources (options.threads);
 #ifndef QUIET
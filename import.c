@@ -7,6 +7,7 @@
 #include "random.h"
 #include "ring.h"
 #include "ruler.h"
+#include "system.h"
 #include "trace.h"
 #include "utilities.h"
 #include "export.h"
@@ -68,11 +69,75 @@ static bool import_units (struct ring *ring) {
   return true;
 }
 
-static void really_import_binary_clause (struct ring *ring, unsigned lit,
-                                         unsigned other) {
+// Clauses imported from the pool of another ring carry their provenance
+// which is accounted for in 'ring->statistics.sharing' while clauses
+// imported from the simplifier or from Mallob do not have one.
+
+struct provenance {
+  struct ring *source;
+  double delay;
+};
+
+static unsigned import_tier (struct ring *ring, unsigned glue) {
+  if (glue <= ring->tier1_glue_limit[ring->stable])
+    return 1;
+  if (glue <= ring->tier2_glue_limit[ring->stable])
+    return 2;
+  return 3;
+}
+
+static void account_imported (struct ring *ring,
+                              const struct provenance *provenance,
+                              unsigned tier) {
+  struct ring_statistics *statistics = &ring->statistics;
+  assert (tier < SIZE_SHARING_TIERS);
+  struct sharing *sharing = statistics->sharing.tiers + tier;
+  sharing->imported++;
+  sharing->delay += provenance->delay;
+  sharing = statistics->sharing.sources + provenance->source->id;
+  sharing->imported++;
+  sharing->delay += provenance->delay;
+}
+
+static void account_retired (struct sharing *sharing,
+                             struct watcher *watcher) {
+  sharing->retired++;
+  sharing->propagated += watcher->propagated;
+  sharing->analyzed += watcher->analyzed;
+  sharing->useful += watcher->propagated || watcher->analyzed;
+}
+
+void retire_imported_watcher (struct ring *ring, struct watcher *watcher) {
+  struct ring_statistics *statistics = &ring->statistics;
+  unsigned tier = watcher->imported;
+  assert (tier);
+  assert (tier < SIZE_SHARING_TIERS);
+  watcher->imported = 0;
+  account_retired (statistics->sharing.tiers + tier, watcher);
+  unsigned source = watcher->clause->origin;
+  if (source < ring->threads)
+    account_retired (statistics->sharing.sources + source, watcher);
+}
+
+// Imported clauses which are still watched at the end have not been
+// retired yet.  They are retired before printing statistics, since
+// otherwise only reduced or collected imported clauses would be counted.
+
+void retire_imported_watchers (struct ruler *ruler) {
+  for (all_rings (ring))
+    for (all_watchers (watcher))
+      if (watcher->imported)
+        retire_imported_watcher (ring, watcher);
+}
+
+static void really_import_binary_clause (
+    struct ring *ring, unsigned lit, unsigned other,
+    const struct provenance *provenance) {
   (void) new_local_binary_clause (ring, true, lit, other);
   trace_add_binary (&ring->trace, lit, other);
   INC_BINARY_CLAUSE_STATISTICS (imported);
+  if (provenance)
+    account_imported (ring, provenance, 0);
 }
 
 static void force_to_repropagate (struct ring *ring, unsigned lit) {
@@ -108,7 +173,8 @@ static bool subsumed_binary (struct ring *ring, unsigned lit,
   return res;
 }
 
-static bool import_binary (struct ring *ring, struct clause *clause) {
+static bool import_binary (struct ring *ring, struct clause *clause,
+                           const struct provenance *provenance) {
   assert (is_binary_pointer (clause));
   assert (redundant_pointer (clause));
   signed char *values = ring->values;
@@ -154,14 +220,14 @@ static bool import_binary (struct ring *ring, struct clause *clause) {
   if (other_value >= 0) {
     SUBSUME_BINARY (lit, other);
     LOGBINARY (true, lit, other, "importing (no propagation)");
-    really_import_binary_clause (ring, lit, other);
+    really_import_binary_clause (ring, lit, other, provenance);
     return false;
   }
 
   if (lit_value > 0 && lit_level <= other_level) {
     SUBSUME_BINARY (lit, other);
     LOGBINARY (true, lit, other, "importing (no propagation)");
-    really_import_binary_clause (ring, lit, other);
+    really_import_binary_clause (ring, lit, other, provenance);
     if (lit_level < other_level && ring->context == PROBING_CONTEXT) {
       ring->statistics.diverged++;
       return true;
@@ -179,7 +245,7 @@ static bool import_binary (struct ring *ring, struct clause *clause) {
     LOGBINARY (true, lit, other, "importing (repropagate first watch %s)",
                LOGLIT (lit));
     force_to_repropagate (ring, lit);
-    really_import_binary_clause (ring, lit, other);
+    really_import_binary_clause (ring, lit, other, provenance);
     return true;
   }
 
@@ -190,7 +256,7 @@ static bool import_binary (struct ring *ring, struct clause *clause) {
   LOGBINARY (true, lit, other, "importing (repropagate second watch %s))",
              LOGLIT (other));
   force_to_repropagate (ring, other);
-  really_import_binary_clause (ring, lit, other);
+  really_import_binary_clause (ring, lit, other, provenance);
 
   return true;
 }
@@ -229,6 +295,7 @@ static bool subsumed_large_clause (struct ring *ring,
     signed char lit_value = values[lit];
     if (lit_value < 0)
       continue;
+    forward_watches (ring, lit);
     struct references *watches = &REFERENCES (lit);
     for (all_watches (watch, *watches)) {
       if (!redundant_pointer (watch))
@@ -251,6 +318,8 @@ static bool subsumed_large_clause (struct ring *ring,
         break;
       }
       struct watcher *watcher = get_watcher (ring, watch);
+      if (watcher->garbage)
+        continue;
       res = true;
       for (all_watcher_literals (other, watcher)) {
         if (other == lit)
@@ -285,12 +354,19 @@ static bool subsumed_large_clause (struct ring *ring,
   return res;
 }
 
-static void really_import_large_clause (struct ring *ring,
-                                        struct clause *clause,
-                                        unsigned first, unsigned second) {
-  watch_literals_in_large_clause (ring, clause, first, second);
+static void really_import_large_clause (
+    struct ring *ring, struct clause *clause, unsigned first,
+    unsigned second, const struct provenance *provenance) {
+  struct watch *watch =
+      watch_literals_in_large_clause (ring, clause, first, second);
   assert (clause->redundant);
-  INC_LARGE_CLAUSE_STATISTICS (imported, clause->glue, clause->size);
+  unsigned glue = clause->glue;
+  INC_LARGE_CLAUSE_STATISTICS (imported, glue, clause->size);
+  if (!provenance)
+    return;
+  unsigned tier = import_tier (ring, glue);
+  get_watcher (ring, watch)->imported = tier;
+  account_imported (ring, provenance, tier);
 }
 
 static unsigned find_literal_to_watch (struct ring *ring,
@@ -330,7 +406,8 @@ static unsigned find_literal_to_watch (struct ring *ring,
   return res;
 }
 
-static bool import_large_clause (struct ring *ring, struct clause *clause) {
+static bool import_large_clause (struct ring *ring, struct clause *clause,
+                                 const struct provenance *provenance) {
   signed char *values = ring->values;
   for (all_literals_in_clause (lit, clause)) {
     if (values[lit] <= 0)
@@ -367,14 +444,14 @@ static bool import_large_clause (struct ring *ring, struct clause *clause) {
   if (other_value >= 0) {
     SUBSUME_LARGE_CLAUSE (clause);
     LOGCLAUSE (clause, "importing (no propagation)");
-    really_import_large_clause (ring, clause, lit, other);
+    really_import_large_clause (ring, clause, lit, other, provenance);
     return false;
   }
 
   if (lit_value > 0 && lit_level <= other_level) {
     SUBSUME_LARGE_CLAUSE (clause);
     LOGCLAUSE (clause, "importing (no propagation)");
-    really_import_large_clause (ring, clause, lit, other);
+    really_import_large_clause (ring, clause, lit, other, provenance);
     if (lit_level < other_level && ring->context == PROBING_CONTEXT) {
       ring->statistics.diverged++;
       return true;
@@ -392,7 +469,7 @@ static bool import_large_clause (struct ring *ring, struct clause *clause) {
     LOGCLAUSE (clause, "importing (repropagate first watch %s)",
                LOGLIT (lit));
     force_to_repropagate (ring, lit);
-    really_import_large_clause (ring, clause, lit, other);
+    really_import_large_clause (ring, clause, lit, other, provenance);
     return true;
   }
 
@@ -403,11 +480,23 @@ static bool import_large_clause (struct ring *ring, struct clause *clause) {
   LOGCLAUSE (clause, "importing (repropagate second watch %s)",
              LOGLIT (other));
   force_to_repropagate (ring, other);
-  really_import_large_clause (ring, clause, lit, other);
+  really_import_large_clause (ring, clause, lit, other, provenance);
 
   return true;
 }
 
+static bool import_clause_with_provenance (
+    struct ring *ring, struct clause *clause,
+    const struct provenance *provenance) {
+  if (is_binary_pointer (clause))
+    return import_binary (ring, clause, provenance);
+  return import_large_clause (ring, clause, provenance);
+}
+
+bool import_clause (struct ring *ring, struct clause *clause) {
+  return import_clause_with_provenance (ring, clause, 0);
+}
+
 bool import_shared (struct ring *ring) {
   if (!ring->pool)
     return false;
@@ -450,9 +539,11 @@ bool import_shared (struct ring *ring) {
     return false;
   }
 
-  if (is_binary_pointer (clause))
-    return import_binary (ring, clause);
-  return import_large_clause (ring, clause);
+  struct provenance provenance = {.source = src, .delay = 0};
+#ifndef QUIET
+  provenance.delay = current_time () - best->exported;
+#endif
+  return import_clause_with_provenance (ring, clause, &provenance);
 }
 
 // Import from Mallob
@@ -494,13 +585,13 @@ static unsigned get_free_slots(struct ring *ring) {
 }
 
 static inline bool import_binary_from_mallob (struct ring *ring, struct watch *clause) {
-  bool res = import_binary(ring, (struct clause *) clause);
+  bool res = import_binary (ring, (struct clause *) clause, 0);
   export_binary_clause(ring, clause, false);
   return res;
 }
 
 static inline bool import_large_clause_from_mallob (struct ring *ring, struct clause *clause) {
-  bool res = import_large_clause (ring, clause);
+  bool res = import_large_clause (ring, clause, 0);
   export_clause (ring, clause, false);
   return res;
 }
@@ -519,6 +610,8 @@ void gimsatul_import_redundant_clauses (struct ring * ring)
   int *buffer = 0;
   int size = 0;
   int glue = 0;
+  if (!ring->produce_clause)
+    return;
   ring->num_conflicts_at_last_import = SEARCH_CONFLICTS;
   struct ruler *ruler = ring->ruler;
   struct unsigneds *clause = ruler->mallob_import_clause;
@@ -6,8 +6,13 @@
 #include <stdbool.h>
 
 struct ring;
+struct ruler;
 struct watch;
+struct watcher;
+bool import_clause (struct ring *, struct clause *);
 bool import_shared (struct ring *);
+void retire_imported_watcher (struct ring *, struct watcher *);
+void retire_imported_watchers (struct ruler *);
 void gimsatul_import_redundant_clauses (struct ring *);
 
 #endif
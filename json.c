@@ -0,0 +1,289 @@
+// For 'flockfile' and 'funlockfile' with '-std=c11'.
+
+#define _DEFAULT_SOURCE
+
+#ifndef QUIET
+
+#include "json.h"
+#include "message.h"
+#include "ruler.h"
+#include "sample.h"
+#include "system.h"
+#include "utilities.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+
+// Statistics are written in the JSON lines format, i.e., every sample and
+// every final record of a ring or the ruler is a JSON object on a line of
+// its own.  Thus the file can already be parsed while still being
+// written.  Each record is written with the file locked, since samples
+// are written by the sampler thread and final records in the main thread
+// or in a signal handler.
+
+struct json {
+  FILE *file;
+  bool comma;
+};
+
+static void json_key (struct json *json, const char *key) {
+  if (json->comma)
+    fputc (',', json->file);
+  json->comma = true;
+  if (key)
+    fprintf (json->file, "\"%s\":", key);
+}
+
+static void begin_json_object (struct json *json, const char *key) {
+  json_key (json, key);
+  fputc ('{', json->file);
+  json->comma = false;
+}
+
+static void end_json_object (struct json *json) {
+  fputc ('}', json->file);
+  json->comma = true;
+}
+
+static void json_string (struct json *json, const char *key,
+                         const char *value) {
+  json_key (json, key);
+  fprintf (json->file, "\"%s\"", value);
+}
+
+static void json_unsigned (struct json *json, const char *key,
+                           uint64_t value) {
+  json_key (json, key);
+  fprintf (json->file, "%" PRIu64, value);
+}
+
+static void json_double (struct json *json, const char *key, double value) {
+  json_key (json, key);
+  fprintf (json->file, "%.3f", value);
+}
+
+static void begin_json_record (struct json *json, FILE *file,
+                               const char *type) {
+  flockfile (file);
+  json->file = file;
+  json->comma = false;
+  begin_json_object (json, 0);
+  json_string (json, "type", type);
+}
+
+static void end_json_record (struct json *json) {
+  end_json_object (json);
+  fputc ('\n', json->file);
+  fflush (json->file);
+  funlockfile (json->file);
+}
+
+#define JSON_CLAUSES(JSON, KEY, CLAUSES) \
+  do { \
+    begin_json_object ((JSON), (KEY)); \
+    json_unsigned ((JSON), "units", (CLAUSES).units); \
+    json_unsigned ((JSON), "clauses", (CLAUSES).clauses); \
+    json_unsigned ((JSON), "binaries", (CLAUSES).binaries); \
+    json_unsigned ((JSON), "tier1", (CLAUSES).tier1); \
+    json_unsigned ((JSON), "tier2", (CLAUSES).tier2); \
+    json_unsigned ((JSON), "tier3", (CLAUSES).tier3); \
+    end_json_object ((JSON)); \
+  } while (0)
+
+/*------------------------------------------------------------------------*/
+
+void write_json_sample (struct file *file, struct sample *sample,
+                        struct sample *last) {
+  if (!file->file)
+    return;
+  struct json json;
+  begin_json_record (&json, file->file, "sample");
+  double delta = sample->time - last->time;
+  json_double (&json, "time", sample->time);
+  json_unsigned (&json, "conflicts", sample->conflicts);
+  json_double (&json, "conflicts_per_second",
+               average (sample->conflicts - last->conflicts, delta));
+  json_unsigned (&json, "decisions", sample->decisions);
+  json_double (&json, "decisions_per_second",
+               average (sample->decisions - last->decisions, delta));
+  json_unsigned (&json, "propagations", sample->propagations);
+  json_double (&json, "propagations_per_second",
+               average (sample->propagations - last->propagations, delta));
+  JSON_CLAUSES (&json, "imported", sample->imported);
+  JSON_CLAUSES (&json, "exported", sample->exported);
+  json_unsigned (&json, "irredundant", sample->irredundant);
+  json_unsigned (&json, "redundant", sample->redundant);
+  json_unsigned (&json, "resident", sample->resident);
+  end_json_record (&json);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void write_json_profile (struct json *json, const char *name,
+                                struct profile *profile) {
+  begin_json_object (json, name);
+  json_double (json, "time", profile->time);
+  struct perf_counters *counted = &profile->perf.counted;
+  if (counted->cycles) {
+#define PERF_COUNTER(NAME) json_unsigned (json, #NAME, counted->NAME);
+    PERF_COUNTERS
+#undef PERF_COUNTER
+    json_unsigned (json, "propagations", counted->propagations);
+  }
+  end_json_object (json);
+}
+
+static const char *context_names[SIZE_CONTEXTS] = {"search", "probing",
+                                                   "walk"};
+
+static void write_json_sharing (struct json *json, const char *name,
+                                struct sharing *sharing) {
+  begin_json_object (json, name);
+  json_unsigned (json, "imported", sharing->imported);
+  json_unsigned (json, "retired", sharing->retired);
+  json_unsigned (json, "propagated", sharing->propagated);
+  json_unsigned (json, "analyzed", sharing->analyzed);
+  json_unsigned (json, "useful", sharing->useful);
+  json_double (json, "delay", sharing->delay);
+  end_json_object (json);
+}
+
+static const char *sharing_names[SIZE_SHARING_TIERS] = {"binary", "tier1",
+                                                        "tier2", "tier3"};
+
+static void write_json_ring (FILE *file, struct ring *ring) {
+  if (verbosity >= 0)
+    flush_ring_profiles (ring);
+  struct json json;
+  begin_json_record (&json, file, "ring");
+  json_unsigned (&json, "id", ring->id);
+  struct ring_statistics *s = &ring->statistics;
+  begin_json_object (&json, "statistics");
+  struct context *c = s->contexts + SEARCH_CONTEXT;
+  json_unsigned (&json, "conflicts", c->conflicts);
+  json_unsigned (&json, "chronological", c->chronological);
+  json_unsigned (&json, "decisions", c->decisions);
+  json_unsigned (&json, "jumped", c->jumped);
+  begin_json_object (&json, "propagations");
+  for (unsigned i = 0; i != SIZE_CONTEXTS; i++)
+    json_unsigned (&json, context_names[i], s->contexts[i].propagations);
+  end_json_object (&json);
+  begin_json_object (&json, "ticks");
+  for (unsigned i = 0; i != SIZE_CONTEXTS; i++)
+    json_unsigned (&json, context_names[i], s->contexts[i].ticks);
+  end_json_object (&json);
+  json_unsigned (&json, "restarts", s->restarts);
+  json_unsigned (&json, "reductions", s->reductions);
+  json_unsigned (&json, "rephased", s->rephased);
+  json_unsigned (&json, "switched", s->switched);
+  json_unsigned (&json, "simplifications", s->simplifications);
+  json_unsigned (&json, "probings", s->probings);
+  json_unsigned (&json, "walked", s->walked);
+  json_unsigned (&json, "flips", s->flips);
+  json_unsigned (&json, "bumped", s->bumped);
+  json_unsigned (&json, "fixed", s->fixed);
+  json_unsigned (&json, "failed", s->failed);
+  json_unsigned (&json, "lifted", s->lifted);
+  json_unsigned (&json, "irredundant", s->irredundant);
+  json_unsigned (&json, "redundant", s->redundant);
+  JSON_CLAUSES (&json, "learned", s->learned);
+  JSON_CLAUSES (&json, "exported", s->exported);
+  JSON_CLAUSES (&json, "imported", s->imported);
+  if (ring->pool) {
+    begin_json_object (&json, "sharing");
+    for (unsigned i = 0; i != SIZE_SHARING_TIERS; i++)
+      write_json_sharing (&json, sharing_names[i], s->sharing.tiers + i);
+    begin_json_object (&json, "sources");
+    for (unsigned i = 0; i != ring->threads; i++) {
+      struct sharing *sharing = s->sharing.sources + i;
+      if (!sharing->imported)
+        continue;
+      char name[16];
+      sprintf (name, "%u", i);
+      write_json_sharing (&json, name, sharing);
+    }
+    end_json_object (&json);
+    end_json_object (&json);
+  }
+  begin_json_object (&json, "reduced");
+  json_unsigned (&json, "clauses", s->reduced.clauses);
+  json_unsigned (&json, "tier1", s->reduced.tier1);
+  json_unsigned (&json, "tier2", s->reduced.tier2);
+  json_unsigned (&json, "tier3", s->reduced.tier3);
+  end_json_object (&json);
+  begin_json_object (&json, "vivify");
+  json_unsigned (&json, "tried", s->vivify.tried);
+  json_unsigned (&json, "succeeded", s->vivify.succeeded);
+  json_unsigned (&json, "strengthened", s->vivify.strengthened);
+  json_unsigned (&json, "subsumed", s->vivify.subsumed);
+  json_unsigned (&json, "implied", s->vivify.implied);
+  json_unsigned (&json, "units", s->vivify.units);
+  end_json_object (&json);
+  end_json_object (&json);
+  begin_json_object (&json, "profiles");
+#define RING_PROFILE(NAME) \
+  write_json_profile (&json, #NAME, &ring->profiles.NAME);
+  RING_PROFILES
+#undef RING_PROFILE
+  end_json_object (&json);
+  end_json_record (&json);
+}
+
+static void write_json_ruler (FILE *file, struct ruler *ruler) {
+  if (verbosity >= 0)
+    flush_ruler_profiles (ruler);
+  struct json json;
+  begin_json_record (&json, file, "ruler");
+  json_unsigned (&json, "variables", ruler->size);
+  json_unsigned (&json, "rings", SIZE (ruler->rings));
+  struct ruler_statistics *s = &ruler->statistics;
+  begin_json_object (&json, "statistics");
+  json_unsigned (&json, "eliminated", s->eliminated);
+  json_unsigned (&json, "definitions", s->definitions);
+  json_unsigned (&json, "substituted", s->substituted);
+  json_unsigned (&json, "deduplicated", s->deduplicated);
+  json_unsigned (&json, "subsumed", s->subsumed);
+  json_unsigned (&json, "strengthened", s->strengthened);
+  json_unsigned (&json, "selfsubsumed", s->selfsubsumed);
+  json_unsigned (&json, "simplifications", s->simplifications);
+  json_unsigned (&json, "weakened", s->weakened);
+  json_unsigned (&json, "binaries", s->binaries);
+  begin_json_object (&json, "fixed");
+  json_unsigned (&json, "simplifying", s->fixed.simplifying);
+  json_unsigned (&json, "solving", s->fixed.solving);
+  json_unsigned (&json, "total", s->fixed.total);
+  end_json_object (&json);
+  begin_json_object (&json, "reclone");
+  json_unsigned (&json, "full", s->reclone.full);
+  json_unsigned (&json, "incremental", s->reclone.incremental);
+  end_json_object (&json);
+  end_json_object (&json);
+  begin_json_object (&json, "profiles");
+#define RULER_PROFILE(NAME) \
+  write_json_profile (&json, #NAME, &ruler->profiles.NAME);
+  RULER_PROFILES
+#undef RULER_PROFILE
+  end_json_object (&json);
+  json_double (&json, "process_time", process_time ());
+  json_double (&json, "wall_clock_time", current_time () - start_time);
+  json_unsigned (&json, "maximum_resident_set_size",
+                 maximum_resident_set_size ());
+  end_json_record (&json);
+}
+
+void write_json_statistics (struct ruler *ruler) {
+  struct file *json = &ruler->options.json;
+  FILE *file = json->file;
+  if (!file)
+    return;
+  json->file = 0;
+  for (all_rings (ring))
+    write_json_ring (file, ring);
+  write_json_ruler (file, ruler);
+  // The sampler is still running if we are called from a signal handler.
+  if (json->close && !ruler->sampler.running)
+    fclose (file);
+  verbose (0, "wrote statistics to '%s'", json->path);
+}
+
+#endif
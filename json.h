@@ -0,0 +1,16 @@
+#ifndef _json_h_INCLUDED
+#define _json_h_INCLUDED
+
+#ifndef QUIET
+
+struct file;
+struct ruler;
+struct sample;
+
+void write_json_sample (struct file *, struct sample *,
+                        struct sample *last);
+void write_json_statistics (struct ruler *);
+
+#endif
+
+#endif
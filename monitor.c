@@ -0,0 +1,185 @@
+// For 'lstat' and 'S_ISSOCK' with '-std=c11'.
+
+#define _DEFAULT_SOURCE
+
+#include "monitor.h"
+#include "allocate.h"
+#include "message.h"
+#include "ruler.h"
+#include "system.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// The rings update these fields without synchronization and thus they
+// are only loaded atomically (without any ordering constraints) here.
+
+#define LOAD(FIELD) __atomic_load_n (&(FIELD), __ATOMIC_RELAXED)
+
+static const char *context_names[SIZE_CONTEXTS] = {"search", "probing",
+                                                   "walk"};
+
+static void take_snapshots (struct ruler *ruler, double now) {
+  struct monitor *monitor = &ruler->monitor;
+  struct ring_snapshot *snapshot = monitor->snapshots;
+  for (all_rings (ring)) {
+    struct ring_statistics *s = &ring->statistics;
+    struct context *c = s->contexts + SEARCH_CONTEXT;
+    uint64_t propagations = 0, ticks = 0;
+    for (unsigned i = 0; i != SIZE_CONTEXTS; i++) {
+      propagations += LOAD (s->contexts[i].propagations);
+      ticks += LOAD (s->contexts[i].ticks);
+    }
+    if (!monitor->samples || propagations != snapshot->propagations ||
+        ticks != snapshot->ticks)
+      snapshot->progress = now;
+    snapshot->propagations = propagations;
+    snapshot->ticks = ticks;
+    snapshot->conflicts = LOAD (c->conflicts);
+    snapshot->decisions = LOAD (c->decisions);
+    snapshot->status = LOAD (ring->status);
+    snapshot->context = LOAD (ring->context);
+    snapshot->level = LOAD (ring->level);
+    snapshot->stable = LOAD (ring->stable);
+    snapshot->walker = LOAD (ring->walker);
+    unsigned *begin = LOAD (ring->trail.begin);
+    unsigned *end = LOAD (ring->trail.end);
+    snapshot->trail = begin <= end ? (size_t) (end - begin) : 0;
+    snapshot++;
+  }
+  monitor->time = now;
+  monitor->samples++;
+}
+
+static void serve_snapshots (struct ruler *ruler) {
+  struct monitor *monitor = &ruler->monitor;
+  int client = accept (monitor->socket, 0, 0);
+  if (client < 0)
+    return;
+  double time = monitor->time - start_time;
+  char line[512];
+  for (size_t i = 0; i != monitor->size; i++) {
+    struct ring_snapshot *snapshot = monitor->snapshots + i;
+    unsigned context = snapshot->context;
+    const char *name =
+        context < SIZE_CONTEXTS ? context_names[context] : "unknown";
+    int bytes = snprintf (
+        line, sizeof line,
+        "{\"time\":%.3f,\"ring\":%zu,\"status\":%d,\"context\":\"%s\","
+        "\"mode\":\"%s\",\"walker\":%s,\"level\":%u,\"trail\":%zu,"
+        "\"conflicts\":%" PRIu64 ",\"decisions\":%" PRIu64
+        ",\"propagations\":%" PRIu64 ",\"ticks\":%" PRIu64
+        ",\"stalled\":%.3f}\n",
+        time, i, snapshot->status, name,
+        snapshot->stable ? "stable" : "focused",
+        snapshot->walker ? "true" : "false", snapshot->level,
+        snapshot->trail, snapshot->conflicts, snapshot->decisions,
+        snapshot->propagations, snapshot->ticks,
+        monitor->time - snapshot->progress);
+    assert (0 < bytes && (size_t) bytes < sizeof line);
+    // Clients which went away must not raise 'SIGPIPE'.
+    if (send (client, line, bytes, MSG_NOSIGNAL) != bytes)
+      break;
+  }
+  close (client);
+  monitor->served++;
+}
+
+static void *monitor_rings (void *ptr) {
+  struct ruler *ruler = ptr;
+  struct monitor *monitor = &ruler->monitor;
+  unsigned interval = ruler->options.monitor_interval;
+  struct pollfd fds[2] = {{.fd = monitor->socket, .events = POLLIN},
+                          {.fd = monitor->wakeup[0], .events = POLLIN}};
+  double next = 0;
+  for (;;) {
+    double now = current_time ();
+    if (now >= next) {
+      take_snapshots (ruler, now);
+      next = now + interval * 1e-3;
+    }
+    // With an unlimited interval the delay does not fit into an 'int'.
+    double delay = (next - now) * 1e3 + 1;
+    int timeout = delay < INT_MAX ? delay : INT_MAX;
+    int res = poll (fds, 2, timeout);
+    if (res < 0 && errno != EINTR)
+      break;
+    if (res <= 0)
+      continue;
+    if (fds[1].revents)
+      break;
+    if (fds[0].revents & POLLIN)
+      serve_snapshots (ruler);
+  }
+  return 0;
+}
+
+void start_monitor (struct ruler *ruler) {
+  const char *path = ruler->options.monitor;
+  if (!path)
+    return;
+  struct monitor *monitor = &ruler->monitor;
+  assert (!monitor->running);
+  struct sockaddr_un address;
+  memset (&address, 0, sizeof address);
+  address.sun_family = AF_UNIX;
+  if (strlen (path) >= sizeof address.sun_path)
+    fatal_error ("monitor socket path '%s' too long", path);
+  strcpy (address.sun_path, path);
+  monitor->socket = socket (AF_UNIX, SOCK_STREAM, 0);
+  if (monitor->socket < 0)
+    fatal_error ("failed to create monitor socket");
+  // Only replace stale sockets (of previous runs) and never other files.
+  struct stat buf;
+  if (!lstat (path, &buf)) {
+    if (!S_ISSOCK (buf.st_mode))
+      fatal_error ("monitor socket path '%s' exists but is not a socket",
+                   path);
+    (void) unlink (path);
+  }
+  if (bind (monitor->socket, (struct sockaddr *) &address, sizeof address))
+    fatal_error ("failed to bind monitor socket to '%s'", path);
+  if (listen (monitor->socket, 16))
+    fatal_error ("failed to listen on monitor socket '%s'", path);
+  if (pipe (monitor->wakeup))
+    fatal_error ("failed to create monitor wake-up pipe");
+  monitor->size = SIZE (ruler->rings);
+  monitor->snapshots =
+      allocate_and_clear_array (monitor->size, sizeof *monitor->snapshots);
+  if (pthread_create (&monitor->thread, 0, monitor_rings, ruler))
+    fatal_error ("failed to create monitor thread");
+  monitor->running = true;
+  verbose (0, "monitoring %zu rings every %u ms on '%s'", monitor->size,
+           ruler->options.monitor_interval, path);
+}
+
+void stop_monitor (struct ruler *ruler) {
+  struct monitor *monitor = &ruler->monitor;
+  if (!monitor->running)
+    return;
+  char byte = 0;
+  if (write (monitor->wakeup[1], &byte, 1) != 1)
+    fatal_error ("failed to wake up monitor thread");
+  if (pthread_join (monitor->thread, 0))
+    fatal_error ("failed to join monitor thread");
+  close (monitor->wakeup[0]);
+  close (monitor->wakeup[1]);
+  close (monitor->socket);
+  (void) unlink (ruler->options.monitor);
+  free (monitor->snapshots);
+  monitor->snapshots = 0;
+  monitor->running = false;
+  verbose (0,
+           "monitor took %" PRIu64 " snapshots and served %" PRIu64
+           " clients",
+           monitor->samples, monitor->served);
+}
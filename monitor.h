@@ -0,0 +1,49 @@
+#ifndef _monitor_h_INCLUDED
+#define _monitor_h_INCLUDED
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+struct ruler;
+
+// With '--monitor=<socket>' a monitoring thread takes a snapshot of the
+// live state of every ring each 'monitor_interval' milliseconds and listens
+// on a local Unix domain socket.  Each client connecting to that socket
+// gets the latest snapshot as one JSON line per ring and the connection is
+// closed again.  The counters of the rings are read with relaxed atomic
+// loads and the rings never wait for nor write to the monitor.  For each
+// ring the snapshot contains the seconds since its propagations and ticks
+// last changed, which allows to detect stalled or dead rings.
+
+struct ring_snapshot {
+  int status;
+  unsigned context;
+  unsigned level;
+  bool stable;
+  bool walker;
+  size_t trail;
+  uint64_t conflicts;
+  uint64_t decisions;
+  uint64_t propagations;
+  uint64_t ticks;
+  double progress;
+};
+
+struct monitor {
+  pthread_t thread;
+  bool running;
+  int socket;
+  int wakeup[2];
+  double time;
+  size_t size;
+  struct ring_snapshot *snapshots;
+  uint64_t samples;
+  uint64_t served;
+};
+
+void start_monitor (struct ruler *);
+void stop_monitor (struct ruler *);
+
+#endif
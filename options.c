@@ -273,6 +273,59 @@ void parse_options (int argc, char **argv, struct options *opts) {
         die ("invalid argument in '%s'", opt);
       if (!opts->seconds)
         die ("invalid zero argument in '%s'", opt);
+    } else if (!strncmp (opt, "--scaling=", 10)) {
+#ifdef QUIET
+      die ("configured with '--quiet' (disables '%s')", opt);
+#else
+      if (opts->scalings)
+        die ("multiple '--scaling=...' options");
+      const char *p = opt + 10;
+      for (;;) {
+        unsigned threads = 0;
+        if (!isdigit (*p))
+          die ("invalid argument in '%s'", opt);
+        while (isdigit (*p)) {
+          threads = 10 * threads + (*p++ - '0');
+          if (threads > MAX_THREADS)
+            die ("invalid argument in '%s' (maximum %u)", opt, MAX_THREADS);
+        }
+        if (!threads)
+          die ("invalid zero thread count in '%s'", opt);
+        if (opts->scalings == MAX_SCALINGS)
+          die ("too many thread counts in '%s' (maximum %u)", opt,
+               MAX_SCALINGS);
+        opts->scaling[opts->scalings++] = threads;
+        if (!*p)
+          break;
+        if (*p++ != ',')
+          die ("invalid argument in '%s'", opt);
+      }
+#endif
+    } else if (!strncmp (opt, "--monitor=", 10)) {
+      if (opts->monitor)
+        die ("multiple '--monitor=%s' and '%s'", opts->monitor, opt);
+      opts->monitor = opt + 10;
+      if (!*opts->monitor)
+        die ("missing socket in '%s'", opt);
+    } else if (!strncmp (opt, "--stats-json=", 13)) {
+#ifdef QUIET
+      die ("configured with '--quiet' (disables '%s')", opt);
+#else
+      if (opts->json.file)
+        die ("multiple '--stats-json=%s' and '%s'", opts->json.path, opt);
+      const char *path = opt + 13;
+      if (!*path)
+        die ("missing file in '%s'", opt);
+      if (!strcmp (path, "-")) {
+        opts->json.path = "<stdout>";
+        opts->json.file = stdout;
+      } else if (!(opts->json.file = fopen (path, "w")))
+        die ("can not open and write to '%s'", path);
+      else {
+        opts->json.path = path;
+        opts->json.close = true;
+      }
+#endif
     }
 #define OPTION(TYPE, NAME, DEFAULT, MIN, MAX, DESCRIPTION) \
   else if (opt[0] == '-' && opt[1] == '-' && opt[2] == 'n' && \
@@ -342,6 +395,22 @@ void parse_options (int argc, char **argv, struct options *opts) {
     opts->dimacs.file = stdin;
   }
 
+  if (opts->scalings) {
+    if (opts->threads)
+      die ("can not combine '--scaling=...' and '--threads=%u'",
+           opts->threads);
+    if (opts->proof.file)
+      die ("can not write proof with '--scaling=...'");
+    if (opts->json.file)
+      die ("can not combine '--scaling=...' and '--stats-json=%s'",
+           opts->json.path);
+    if (opts->dimacs.close != 1)
+      die ("'--scaling=...' requires uncompressed DIMACS file");
+    for (unsigned i = 0; i != opts->scalings; i++)
+      if (opts->scaling[i] > opts->threads)
+        opts->threads = opts->scaling[i];
+  }
+
   if (!opts->threads)
     opts->threads = 1;
 
@@ -17,6 +17,7 @@
 #define MAX_GLUE 255
 #define MAX_SCORE 1e150
 #define MAX_THREADS (1u << 16)
+#define MAX_SCALINGS 32
 
 #define CACHE_LINE_SIZE 128
 
@@ -47,6 +48,7 @@
 
 #define RELATIVE_VIVIFY_TIER1_EFFORT 1
 #define RELATIVE_VIVIFY_TIER2_EFFORT 1
+#define RELATIVE_VIVIFY_IRREDUNDANT_EFFORT 1
 
 #define WALK_EFFORT 0.02
 
@@ -63,6 +65,7 @@
   OPTION (bool, calculate_tiers, 1, 0, 1, "use calculated tier limits") \
   OPTION (unsigned, clause_size_limit, 100, 3, 10000, "during simplification") \
   OPTION (bool, chronological, 1, 0, 1, "enable chronological backtracking") \
+  OPTION (unsigned, compress_clauses, 0, 0, INF, "compress irredundant clauses of at least this size (0=disabled)") \
   OPTION (bool, deduplicate, 1, 0, 1, "remove duplicated binary clauses") \
   OPTION (unsigned, eagerly_subsume, 4, 0, 4, "eagerly subsumed last learned clauses") \
   OPTION (bool, eliminate, 1, 0, 1, "bounded variable elimination") \
@@ -72,11 +75,14 @@
   OPTION (bool, focus_initially, 1, 0, 1, "start with focus mode initially") \
   OPTION (bool, force_phase, 0, 0, 1, "force phase (same phase for all solvers") \
   OPTION (bool, force, 0, 0, 1, "force relaxed parsing and proof writing") \
+  OPTION (bool, huge_pages, 0, 0, 1, "back large arrays by transparent huge pages") \
   OPTION (unsigned, increase_imported_glue, 0, 0, 2, "increase glue imported glue (2=max)") \
   OPTION (bool, limit_import_rate, 1, 0, 1, "adapt import to learned clause rate") \
   OPTION (bool, minimize, 1, 0, 1, "minimize learned clauses") \
   OPTION (unsigned, minimize_depth, 1000, 1, INF, "recursive clause minimization depth") \
+  OPTION (unsigned, monitor_interval, 100, 1, INF, "monitoring snapshot interval in milliseconds") \
   OPTION (unsigned, occurrence_limit, 1000, 0, INF, "literal occurrence limit in simplification") \
+  OPTION (bool, perf_counters, 0, 0, 1, "hardware performance counters in profiles") \
   OPTION (bool, phase, 1, 0, 1, "initial decision phase") \
   OPTION (bool, portfolio, 1, 0, 1, "threads use different strategies") \
   OPTION (bool, probe, 1, 0, 1, "enable probing based inprocessing") \
@@ -87,18 +93,24 @@
   OPTION (unsigned, random_decision_length, 1, 1, INF, "random conflicts length") \
   OPTION (bool, random_stable_decisions, 0, 0, 1, "random focused decisions") \
   OPTION (bool, random_order, 0, 0, 1, "initial random decision order") \
+  OPTION (bool, reduce_forward, 1, 0, 1, "lazy forwarding of watches after reduction") \
+  OPTION (unsigned, reduce_garbage, 50, 0, 100, "flush garbage watchers during reduction above this percentage") \
   OPTION (unsigned, reduce_interval, 1e3, 1, 1e5, "reduce base conflict interval") \
   OPTION (bool, rephase, 1, 0, 1, "reset saved phases regularly") \
   OPTION (unsigned, rephase_interval, 1e3, 1, INF, "base rephase conflict interval") \
   OPTION (unsigned, report, 1, 0, INF, "report details for many threads") \
+  OPTION (unsigned, sample_conflicts, 0, 0, INF, "statistics sampling conflict interval (0=disabled)") \
+  OPTION (unsigned, sample_seconds, 1, 0, INF, "statistics sampling interval in seconds (0=disabled)") \
   OPTION (bool, share_learned, 1, 0, 1, "export and import learned clauses") \
   OPTION (bool, share_by_size, 0, 0, 1, "prioritize shared clauses by size and not glue") \
   OPTION (bool, shrink, 1, 0, 1, "shrink (glue 1) learned clauses") \
   OPTION (bool, simplify, 1, 0, 1, "elimination, subsumption and substitution") \
+  OPTION (bool, simplify_async, 0, 0, 1, "additional asynchronous simplification") \
   OPTION (unsigned, simplify_boost, 1, 0, 1, "additional initial boost to simplification") \
   OPTION (unsigned, simplify_boost_rounds, 4, 2, INF, "initial increase rounds limit") \
   OPTION (unsigned, simplify_boost_ticks, 10, 2, INF, "initial increase of ticks limits") \
   OPTION (unsigned, simplify_interval, 500, 1, INF, "simplification base conflict interval") \
+  OPTION (unsigned, simplify_incremental, 0, 0, 100, "incremental re-cloning up to fixed percent") \
   OPTION (bool, simplify_initially, 1, 0, 1, "initial preprocessing through simplification") \
   OPTION (bool, simplify_regularly, 1, 0, 1, "regular inprocessing through simplification") \
   OPTION (unsigned, simplify_rounds, 4, 1, INF, "number of rounds per simplification") \
@@ -106,13 +118,18 @@
   OPTION (bool, switch_mode, 1, 0, 1, "switch between focused and stable mode") \
   OPTION (unsigned, switch_interval, 1e3, 1, INF, "mode switching base conflict interval") \
   OPTION (bool, substitute, 1, 0, 1, "equivalent literal substitution") \
+  OPTION (unsigned, substitute_parallel, 1e5, 0, INF, "parallel substitution binary clauses limit") \
   OPTION (bool, subsume, 1, 0, 1, "clause subsumption and strengthening") \
   OPTION (bool, subsume_imported, 1, 0, 1, "subsume imported clauses") \
   OPTION (unsigned, subsume_ticks, 20, 0, INF, "subsumption ticks limit in millions") \
   OPTION (unsigned, target_phases, 1, 0, 2, "target phases (2 = in focused mode too)") \
+  OPTION (unsigned, vectorize, 3, 0, 3, "replacement search (0=portable, 1=avx2, 2=avx512, 3=fastest)") \
   OPTION (bool, vivify, 1, 0, 1, "vivification of redundant clauses") \
   OPTION (bool, vivify_export, 1, 0, 1, "export vivified clauses") \
+  OPTION (bool, vivify_irredundant, 1, 0, 1, "vivify slice of shared irredundant clauses") \
   OPTION (bool, walk_initially, 0, 0, 1, "local search initially") \
+  OPTION (bool, walk_persistent, 1, 0, 1, "keep local search counters between walks") \
+  OPTION (unsigned, walkers, 0, 0, MAX_THREADS, "dedicated local search threads") \
   OPTION (bool, warm_up_walking, 1, 0, 1, "unit propagation warm-up of local search") \
   OPTION (bool, witness, 1, 0, 1, "print satisfying assignment")
 
@@ -123,6 +140,8 @@ struct options {
   unsigned seconds;
   unsigned threads;
   unsigned optimize;
+  unsigned scalings;
+  unsigned scaling[MAX_SCALINGS];
   bool summarize;
 
 #define OPTION(TYPE, NAME, DEFAULT, MIN, MAX, DESCRIPTION) TYPE NAME;
@@ -130,6 +149,8 @@ struct options {
 #undef OPTION
   struct file dimacs;
   struct file proof;
+  struct file json;
+  const char *monitor;
 };
 
 /*------------------------------------------------------------------------*/
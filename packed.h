@@ -0,0 +1,58 @@
+#ifndef _packed_h_INCLUDED
+#define _packed_h_INCLUDED
+
+#ifdef PACKED_VALUES
+
+#include "macros.h"
+
+#include <stddef.h>
+
+struct ring;
+
+// With 'PACKED_VALUES' defined (see '--packed-values' in 'configure') each
+// ring keeps besides the byte per literal values array a packed copy with
+// two bits per variable, one bit per literal, which is set if and only if
+// that literal is assigned to true.  Both bits of a variable are in the
+// same byte.  The copy is only read in the hot loops of propagation and
+// local search and thus needs a quarter of the cache lines of the values
+// array there.  All other code keeps using the values array.  The copy is
+// updated whenever values are assigned or unassigned (or set in bulk by
+// the local search which then repacks all values).
+
+static inline size_t bytes_packed_values (size_t size) {
+  return (2 * size + 7) / 8;
+}
+
+static inline signed char packed_value (const unsigned char *packed,
+                                        unsigned lit) {
+  unsigned pair = packed[lit >> 3] >> (lit & 6);
+  unsigned sign = lit & 1;
+  return (signed char) ((pair >> sign) & 1) -
+         (signed char) ((pair >> (sign ^ 1)) & 1);
+}
+
+static inline void assign_packed_value (unsigned char *packed,
+                                        unsigned lit) {
+  unsigned char *p = packed + (lit >> 3);
+  *p = (*p & ~(3u << (lit & 6))) | (1u << (lit & 7));
+}
+
+static inline void unassign_packed_value (unsigned char *packed,
+                                          unsigned lit) {
+  packed[lit >> 3] &= ~(3u << (lit & 6));
+}
+
+void pack_values (struct ring *);
+
+// Access to the value of 'LIT' in hot loops which have a local 'packed'
+// respectively 'values' pointer.
+
+#define VALUE(LIT) packed_value (packed, (LIT))
+
+#else
+
+#define VALUE(LIT) values[LIT]
+
+#endif
+
+#endif
@@ -0,0 +1,259 @@
+// Declares 'syscall' also with '-std=c11' (see './configure -p').
+
+#define _DEFAULT_SOURCE
+
+#ifndef QUIET
+
+#include "perf.h"
+#include "message.h"
+#include "ruler.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+bool perf_counting;
+
+enum {
+#define PERF_COUNTER(NAME) PERF_##NAME,
+  PERF_COUNTERS
+#undef PERF_COUNTER
+      SIZE_PERF_COUNTERS
+};
+
+// Each thread counts its own hardware events in one group of counters,
+// which is read with a single system call.  The group of the main thread
+// is opened in 'init_perf_counters' and the groups of ring threads in
+// 'start_ring_perf_counters'.  Counters which can not be opened are
+// skipped, e.g., last level cache misses in some virtual machines, but
+// without cycle counter all counting is disabled.  Profiles started in
+// one thread but stopped in another one (as 'solve' of the ruler) or
+// started in threads without group are not counted.
+
+struct perf_group {
+  int fds[SIZE_PERF_COUNTERS];
+  signed char position[SIZE_PERF_COUNTERS];
+  unsigned size;
+  bool owned;
+  struct ring *ring;
+};
+
+static _Thread_local struct perf_group group;
+
+// With '--huge-pages' but without '--perf-counters' a single data TLB miss
+// counter is opened in the main thread instead.  It is inherited by all
+// threads started afterwards and their counts are added to it as soon as
+// they are joined.  With '--perf-counters' the process-wide number of data
+// TLB misses is summed up over the groups of the rings instead, as another
+// inherited counter would take a slot in every thread and make the groups
+// multiplex.
+
+static bool tlb_misses_grouped;
+
+static uint64_t ring_propagations (struct ring *ring) {
+  uint64_t res = 0;
+  for (unsigned i = 0; i != SIZE_CONTEXTS; i++)
+    res += ring->statistics.contexts[i].propagations;
+  return res;
+}
+
+#ifdef __linux__
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Same order as in 'PERF_COUNTERS'.
+
+static const struct {
+  uint32_t type;
+  uint64_t config;
+} perf_events[SIZE_PERF_COUNTERS] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+                             (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+static bool open_perf_group (void) {
+  assert (!group.size);
+  int leader = -1;
+  for (unsigned i = 0; i != SIZE_PERF_COUNTERS; i++) {
+    struct perf_event_attr attr;
+    memset (&attr, 0, sizeof attr);
+    attr.size = sizeof attr;
+    attr.type = perf_events[i].type;
+    attr.config = perf_events[i].config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    int fd = syscall (SYS_perf_event_open, &attr, 0, -1, leader, 0);
+    group.fds[i] = fd;
+    if (fd < 0) {
+      group.position[i] = -1;
+      if (i)
+        continue;
+      return false;
+    }
+    if (leader < 0)
+      leader = fd;
+    group.position[i] = group.size++;
+  }
+  return true;
+}
+
+static int tlb_misses_file_descriptor = -1;
+
+static void open_tlb_misses_counter (void) {
+  struct perf_event_attr attr;
+  memset (&attr, 0, sizeof attr);
+  attr.size = sizeof attr;
+  attr.type = perf_events[PERF_dtlb_misses].type;
+  attr.config = perf_events[PERF_dtlb_misses].config;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  tlb_misses_file_descriptor =
+      syscall (SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static bool read_tlb_misses_counter (uint64_t *res) {
+  if (tlb_misses_file_descriptor < 0)
+    return false;
+  return read (tlb_misses_file_descriptor, res, sizeof *res) ==
+         sizeof *res;
+}
+
+static void close_perf_group (void) {
+  for (unsigned i = SIZE_PERF_COUNTERS; i--;)
+    if (group.fds[i] >= 0)
+      close (group.fds[i]);
+  group.size = 0;
+}
+
+static bool read_perf_counters (struct perf_counters *counters) {
+  if (!group.size)
+    return false;
+  uint64_t buffer[SIZE_PERF_COUNTERS + 1];
+  size_t bytes = (group.size + 1) * sizeof *buffer;
+  if (read (group.fds[PERF_cycles], buffer, bytes) != (ssize_t) bytes)
+    return false;
+  assert (buffer[0] == group.size);
+  const uint64_t *values = buffer + 1;
+  const signed char *position = group.position;
+#define PERF_COUNTER(NAME) \
+  counters->NAME = *position < 0 ? 0 : values[(unsigned) *position]; \
+  position++;
+  PERF_COUNTERS
+#undef PERF_COUNTER
+  counters->propagations = group.ring ? ring_propagations (group.ring) : 0;
+  return true;
+}
+
+#else
+
+static bool open_perf_group (void) {
+  errno = ENOSYS;
+  return false;
+}
+
+static void open_tlb_misses_counter (void) {}
+
+static bool read_tlb_misses_counter (uint64_t *res) {
+  (void) res;
+  return false;
+}
+
+static void close_perf_group (void) {}
+
+static bool read_perf_counters (struct perf_counters *counters) {
+  (void) counters;
+  return false;
+}
+
+#endif
+
+void init_perf_counters (struct options *options) {
+  if (verbosity < 0)
+    return;
+  if (!options->perf_counters) {
+    if (options->huge_pages)
+      open_tlb_misses_counter ();
+    return;
+  }
+  if (!open_perf_group ()) {
+    message (0, "hardware performance counters unavailable: %s",
+             strerror (errno));
+    return;
+  }
+  perf_counting = true;
+  tlb_misses_grouped = group.position[PERF_dtlb_misses] >= 0;
+  verbose (0, "opened %u of %u hardware performance counters", group.size,
+           (unsigned) SIZE_PERF_COUNTERS);
+}
+
+bool tlb_misses (struct ruler *ruler, uint64_t *res) {
+  if (!tlb_misses_grouped)
+    return read_tlb_misses_counter (res);
+  uint64_t misses = 0;
+  for (all_rings (ring))
+    misses += ring->profiles.solve.perf.counted.dtlb_misses;
+  *res = misses;
+  return true;
+}
+
+void start_perf_profile (struct perf_profile *profile) {
+  if (read_perf_counters (&profile->started))
+    profile->group = &group;
+}
+
+void stop_perf_profile (struct perf_profile *profile) {
+  const void *started = profile->group;
+  if (!started)
+    return;
+  profile->group = 0;
+  if (started != &group)
+    return;
+  struct perf_counters stopped;
+  if (!read_perf_counters (&stopped))
+    return;
+#define PERF_COUNTER(NAME) \
+  profile->counted.NAME += stopped.NAME - profile->started.NAME;
+  PERF_COUNTERS
+#undef PERF_COUNTER
+  profile->counted.propagations +=
+      stopped.propagations - profile->started.propagations;
+}
+
+void start_ring_perf_counters (struct ring *ring) {
+  if (!perf_counting)
+    return;
+  if (!group.size) {
+    if (!open_perf_group ()) {
+      verbose (ring, "hardware performance counters unavailable: %s",
+               strerror (errno));
+      return;
+    }
+    group.owned = true;
+  }
+  group.ring = ring;
+  start_perf_profile (&ring->profiles.solve.perf);
+}
+
+void stop_ring_perf_counters (struct ring *ring) {
+  if (!perf_counting)
+    return;
+  stop_perf_profile (&ring->profiles.solve.perf);
+  group.ring = 0;
+  if (!group.owned)
+    return;
+  close_perf_group ();
+  group.owned = false;
+}
+
+#endif
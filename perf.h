@@ -0,0 +1,46 @@
+#ifndef _perf_h_INCLUDED
+#define _perf_h_INCLUDED
+
+#ifndef QUIET
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define PERF_COUNTERS \
+  PERF_COUNTER (cycles) \
+  PERF_COUNTER (instructions) \
+  PERF_COUNTER (cache_misses) \
+  PERF_COUNTER (dtlb_misses) \
+  PERF_COUNTER (branch_misses)
+
+struct perf_counters {
+#define PERF_COUNTER(NAME) uint64_t NAME;
+  PERF_COUNTERS
+#undef PERF_COUNTER
+  uint64_t propagations;
+};
+
+struct perf_profile {
+  const void *group;
+  struct perf_counters started;
+  struct perf_counters counted;
+};
+
+struct options;
+struct ring;
+struct ruler;
+
+extern bool perf_counting;
+
+void init_perf_counters (struct options *);
+bool tlb_misses (struct ruler *, uint64_t *);
+
+void start_perf_profile (struct perf_profile *);
+void stop_perf_profile (struct perf_profile *);
+
+void start_ring_perf_counters (struct ring *);
+void stop_ring_perf_counters (struct ring *);
+
+#endif
+
+#endif
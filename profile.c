@@ -12,6 +12,8 @@ double start_profile (struct profile *profile, double time) {
   double volatile *p = &profile->start;
   assert (*p < 0);
   *p = time;
+  if (perf_counting)
+    start_perf_profile (&profile->perf);
   return time;
 }
 
@@ -20,6 +22,8 @@ double stop_profile (struct profile *profile, double time) {
   double delta = time - *p;
   *p = -1;
   profile->time += delta;
+  if (profile->perf.group)
+    stop_perf_profile (&profile->perf);
   return time;
 }
 
@@ -31,6 +35,10 @@ static void flush_profile (double time, struct profile *profile) {
   double delta = time - *p;
   *p = time;
   profile->time += delta;
+  if (!profile->perf.group)
+    return;
+  stop_perf_profile (&profile->perf);
+  start_perf_profile (&profile->perf);
 }
 
 static int cmp_profiles (struct profile *a, struct profile *b) {
@@ -45,6 +53,47 @@ static int cmp_profiles (struct profile *a, struct profile *b) {
   return strcmp (b->name, a->name);
 }
 
+// Hardware counters are given as instructions per cycle (IPC) and misses
+// either per propagation (rings) or per thousand instructions (ruler).
+
+static void print_perf_profile (struct ring *ring, struct profile *profile,
+                                bool per_propagation) {
+  struct perf_counters *counted = &profile->perf.counted;
+  if (!counted->cycles)
+    return;
+  double ipc = average (counted->instructions, counted->cycles);
+  double scale;
+  if (per_propagation)
+    scale = average (1, counted->propagations);
+  else
+    scale = average (1e3, counted->instructions);
+  PRINTLN ("%10.2f IPC %9.2f llc %9.2f dtlb %9.2f branch  %s", ipc,
+           scale * counted->cache_misses, scale * counted->dtlb_misses,
+           scale * counted->branch_misses, profile->name);
+}
+
+static void print_perf_profiles (struct ring *ring, struct profile *begin,
+                                 struct profile *end, struct profile *total,
+                                 bool per_propagation) {
+  if (!perf_counting)
+    return;
+  fputs ("c\n", stdout);
+  PRINTLN ("hardware counters with misses per %s:",
+           per_propagation ? "propagation" : "thousand instructions");
+  struct profile *prev = 0;
+  for (;;) {
+    struct profile *next = 0;
+    for (struct profile *tmp = begin; tmp != end; tmp++)
+      if (cmp_profiles (tmp, prev) < 0 && cmp_profiles (next, tmp) < 0)
+        next = tmp;
+    if (!next)
+      break;
+    print_perf_profile (ring, next, per_propagation);
+    prev = next;
+  }
+  print_perf_profile (ring, total, per_propagation);
+}
+
 /*------------------------------------------------------------------------*/
 
 #define begin_ring_profiles ((struct profile *) (&ring->profiles))
@@ -56,7 +105,7 @@ static int cmp_profiles (struct profile *a, struct profile *b) {
   PROFILE != END_##PROFILE; \
   ++PROFILE
 
-static double flush_ring_profiles (struct ring *ring) {
+double flush_ring_profiles (struct ring *ring) {
   double time = current_time ();
   for (all_ring_profiles (profile))
     if (profile->start >= 0)
@@ -84,6 +133,16 @@ void print_ring_profiles (struct ring *ring) {
   }
   PRINTLN ("-----------------------------------------");
   PRINTLN ("%10.2f seconds  100.0 %%  solving", solving);
+  print_perf_profiles (ring, begin_ring_profiles, end_ring_profiles,
+                       &ring->profiles.solve, true);
+  if (ring->threads > 1) {
+    struct ruler *ruler = ring->ruler;
+    fputs ("c\n", stdout);
+#define BARRIER(NAME) \
+  print_barrier_waits (ring, &ruler->barriers.NAME, solving);
+    BARRIERS
+#undef BARRIER
+  }
   fputs ("c\n", stdout);
   fflush (stdout);
 }
@@ -99,7 +158,7 @@ void print_ring_profiles (struct ring *ring) {
   PROFILE != END_##PROFILE; \
   ++PROFILE
 
-static double flush_ruler_profiles (struct ruler *ruler) {
+double flush_ruler_profiles (struct ruler *ruler) {
   double time = current_time ();
   for (all_ruler_profiles (profile))
     if (profile->start >= 0)
@@ -127,6 +186,14 @@ void print_ruler_profiles (struct ruler *ruler) {
   }
   PRINTLN ("--------------------------------------------");
   PRINTLN ("%10.2f seconds  100.0 %%  total", total);
+  print_perf_profiles (ring, begin_ruler_profiles, end_ruler_profiles,
+                       &ruler->profiles.total, false);
+  if (SIZE (ruler->rings) > 1) {
+    fputs ("c\n", stdout);
+#define BARRIER(NAME) print_barrier_skew (&ruler->barriers.NAME, total);
+    BARRIERS
+#undef BARRIER
+  }
   fputs ("c\n", stdout);
   fflush (stdout);
 }
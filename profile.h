@@ -4,16 +4,20 @@
 #ifndef QUIET
 
 #include "message.h"
+#include "perf.h"
 #include "system.h"
 
 struct profile {
   const char *name;
   volatile double start;
   volatile double time;
+  struct perf_profile perf;
 };
 
 #define RING_PROFILES \
+  RING_PROFILE (connect) \
   RING_PROFILE (fail) \
+  RING_PROFILE (flip) \
   RING_PROFILE (focus) \
   RING_PROFILE (probe) \
   RING_PROFILE (reduce) \
@@ -31,10 +35,12 @@ struct ring_profiles {
 };
 
 #define RULER_PROFILES \
+  RULER_PROFILE (async) \
   RULER_PROFILE (clone) \
   RULER_PROFILE (eliminate) \
   RULER_PROFILE (deduplicate) \
   RULER_PROFILE (parse) \
+  RULER_PROFILE (scc) \
   RULER_PROFILE (solve) \
   RULER_PROFILE (simplify) \
   RULER_PROFILE (substitute) \
@@ -2,9 +2,62 @@
 #include "assign.h"
 #include "macros.h"
 #include "message.h"
+#include "packed.h"
+#include "replace.h"
 #include "ruler.h"
 #include "utilities.h"
 
+#ifdef PREFETCH
+
+// With 'PREFETCH' defined (see '--prefetch' in 'configure') the watch list
+// traversal is software-pipelined.  The watcher of a large clause watch
+// 'PREFETCH' watches ahead is prefetched, unless its blocking literal is
+// already satisfied, and half that distance ahead (when the watcher is
+// supposed to be in the cache already) the literals of the clause at
+// which the replacement search will start are prefetched too, unless the
+// literals are kept in the watcher anyhow.
+
+static inline bool satisfied_blocking_literal (struct ring *ring,
+                                               struct watch *watch) {
+  unsigned blocking = other_pointer (watch);
+#ifdef PACKED_VALUES
+  return packed_value (ring->packed, blocking) > 0;
+#else
+  return ring->values[blocking] > 0;
+#endif
+}
+
+static inline void prefetch_watcher (struct ring *ring,
+                                     struct watch *watch) {
+  if (is_binary_pointer (watch))
+    return;
+  if (satisfied_blocking_literal (ring, watch))
+    return;
+  unsigned idx = index_pointer (watch);
+  __builtin_prefetch (index_to_watcher (ring, idx));
+}
+
+#if PREFETCH > 1
+
+static inline void prefetch_clause (struct ring *ring,
+                                    struct watch *watch) {
+  if (is_binary_pointer (watch))
+    return;
+  if (satisfied_blocking_literal (ring, watch))
+    return;
+  unsigned idx = index_pointer (watch);
+  struct watcher *watcher = index_to_watcher (ring, idx);
+  if (watcher->size || watcher->garbage)
+    return;
+  struct clause *clause = watcher->clause;
+  __builtin_prefetch (clause);
+  __builtin_prefetch (clause->literals + watcher->aux[0]);
+}
+
+#endif
+
+#endif
+
 struct watch *ring_propagate (struct ring *ring, bool stop_at_conflict,
                               struct clause *ignore) {
   assert (!ring->inconsistent);
@@ -14,7 +67,11 @@ struct watch *ring_propagate (struct ring *ring, bool stop_at_conflict,
 #ifdef METRICS
   uint64_t *visits = ring->statistics.contexts[ring->context].visits;
 #endif
+#ifdef PACKED_VALUES
+  const unsigned char *packed = ring->packed;
+#else
   signed char *values = ring->values;
+#endif
   uint64_t ticks = 0, propagations = 0;
   while (trail->propagate != trail->end) {
     if (stop_at_conflict && conflict)
@@ -33,12 +90,12 @@ struct watch *ring_propagate (struct ring *ring, bool stop_at_conflict,
     // threads, since these irredundant binary clauses do not change
     // during search (and are collected during cloning of rings).
 
-    unsigned *binaries = watches->binaries;
+    unsigned *binaries = BINARIES (not_lit);
     if (binaries) {
       unsigned other, *p;
       for (p = binaries; (other = *p) != INVALID; p++) {
         struct watch *watch = tag_binary (false, other, not_lit);
-        signed char other_value = values[other];
+        signed char other_value = VALUE (other);
         if (other_value < 0) {
           conflict = watch;
           if (stop_at_conflict)
@@ -55,15 +112,30 @@ struct watch *ring_propagate (struct ring *ring, bool stop_at_conflict,
         break;
     }
 
-    // Then traverse (and update) the watch list of the literal.
+    // Then traverse (and update) the watch list of the literal, which
+    // first has to be forwarded if it is stale after a reduction.
 
+    forward_watches (ring, not_lit);
     struct watch **begin = watches->begin, **q = begin;
     struct watch **end = watches->end, **p = begin;
 
     ticks++;
 
+#ifdef PREFETCH
+    for (struct watch **r = begin; r != end && r != begin + PREFETCH; r++)
+      prefetch_watcher (ring, *r);
+#endif
+
     while (p != end) {
       assert (!stop_at_conflict || !conflict);
+#ifdef PREFETCH
+      if (PREFETCH < end - p)
+        prefetch_watcher (ring, p[PREFETCH]);
+#if PREFETCH > 1
+      if (PREFETCH / 2 < end - p)
+        prefetch_clause (ring, p[PREFETCH / 2]);
+#endif
+#endif
       struct watch *watch = *q++ = *p++;
 
       // This tagged 'watch' pointer is either a binary watch or an
@@ -90,7 +162,7 @@ struct watch *ring_propagate (struct ring *ring, bool stop_at_conflict,
       unsigned blocking = other_pointer (watch);
       assert (lit != blocking);
       assert (not_lit != blocking);
-      signed char blocking_value = values[blocking];
+      signed char blocking_value = VALUE (blocking);
       if (blocking_value > 0)
         continue;
 
@@ -126,12 +198,16 @@ struct watch *ring_propagate (struct ring *ring, bool stop_at_conflict,
 
         ticks++; // ... and pay the prize.
 
-        // Satisfied (and vivified) but not removed clauses (actually
-        // watchers to the clause) might still be watched and should
-        // be ignored during propagation.
+        // Satisfied, reduced or vivified but not yet flushed clauses
+        // (actually watchers to the clause) might still be watched.  As
+        // reductions do not necessarily flush garbage watchers anymore
+        // (see 'reduce.c'), such watches are dropped here lazily.
 
-        if (watcher->garbage) // This induces the 'tick' above.
+        if (watcher->garbage) { // This induces the 'tick' above.
+          ring->statistics.reduced.dropped++;
+          q--;
           continue;
+        }
 
         // Ignore the vivified clause during vivification.
 
@@ -166,7 +242,7 @@ struct watch *ring_propagate (struct ring *ring, bool stop_at_conflict,
         if (other == blocking)
           other_value = blocking_value;
         else {
-          other_value = values[other];
+          other_value = VALUE (other);
           if (other_value > 0) {
             bool redundant = redundant_pointer (watch);
             watch = tag_index (redundant, idx, other);
@@ -201,11 +277,43 @@ struct watch *ring_propagate (struct ring *ring, bool stop_at_conflict,
           for (unsigned *r = literals; r != end_literals; r++) {
             replacement = *r;
             if (replacement != not_lit && replacement != other) {
-              replacement_value = values[replacement];
+              replacement_value = VALUE (replacement);
+              if (replacement_value >= 0)
+                break;
+            }
+          }
+        } else if (clause->compressed) {
+          // Compressed clauses are searched without keeping the position
+          // of the last replacement.  The uncompressed head is checked
+          // first and only if it does not contain a replacement the
+          // compressed tail is decoded (see 'clause.h'), which costs
+          // another 'tick' and is counted as 'decompressed'.
+
+          ticks++;
+          unsigned *literals = clause->literals;
+          unsigned *tail = literals + COMPRESSED_HEAD_SIZE;
+          for (unsigned *r = literals; r != tail; r++) {
+            replacement = *r;
+            if (replacement != not_lit && replacement != other) {
+              replacement_value = VALUE (replacement);
               if (replacement_value >= 0)
                 break;
             }
           }
+          if (replacement_value < 0) {
+            ring->statistics.decompressed++;
+            ticks++;
+            unsigned pos = 0;
+            replacement = 0;
+            for (unsigned i = tail_size_of_clause (clause); i; i--) {
+              replacement = decode_tail_literal (tail, &pos, replacement);
+              if (replacement != not_lit && replacement != other) {
+                replacement_value = VALUE (replacement);
+                if (replacement_value >= 0)
+                  break;
+              }
+            }
+          }
         } else {
           // Now we pay the prize of accessing the actual clause too
           // (one of the following 'clause->size' accesses).
@@ -234,26 +342,48 @@ struct watch *ring_propagate (struct ring *ring, bool stop_at_conflict,
           assert (watcher->aux[0] <= clause->size);
           unsigned *middle_literals = literals + watcher->aux[0];
           unsigned *r = middle_literals;
-          while (r != end_literals) {
-            replacement = *r;
-            if (replacement != not_lit && replacement != other) {
-              replacement_value = values[replacement];
-              if (replacement_value >= 0)
-                break;
+
+          // Long clauses are searched with a (possibly vectorized)
+          // kernel in the same circular order (see 'replace.c').
+
+#ifndef PACKED_VALUES
+          if (clause->size >= MIN_VECTORIZED_CLAUSE_SIZE) {
+            r = find_replacement (values, r, end_literals, not_lit, other);
+            bool found = r != end_literals;
+            if (!found) {
+              r = find_replacement (values, literals, middle_literals,
+                                    not_lit, other);
+              found = r != middle_literals;
             }
-            r++;
-          }
-          if (replacement_value < 0) {
-            r = literals;
-            while (r != middle_literals) {
+            if (found) {
+              replacement = *r;
+              replacement_value = VALUE (replacement);
+              assert (replacement_value >= 0);
+            }
+          } else
+#endif
+          {
+            while (r != end_literals) {
               replacement = *r;
               if (replacement != not_lit && replacement != other) {
-                replacement_value = values[replacement];
+                replacement_value = VALUE (replacement);
                 if (replacement_value >= 0)
                   break;
               }
               r++;
             }
+            if (replacement_value < 0) {
+              r = literals;
+              while (r != middle_literals) {
+                replacement = *r;
+                if (replacement != not_lit && replacement != other) {
+                  replacement_value = VALUE (replacement);
+                  if (replacement_value >= 0)
+                    break;
+                }
+                r++;
+              }
+            }
           }
           watcher->aux[0] = r - literals;
         }
@@ -270,6 +400,7 @@ struct watch *ring_propagate (struct ring *ring, bool stop_at_conflict,
           if (stop_at_conflict)
             break;
         } else {
+          watcher->propagated = true;
           assign_with_reason (ring, other, watch);
           ticks++;
         }
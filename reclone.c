@@ -0,0 +1,311 @@
+#include "reclone.h"
+#include "assign.h"
+#include "message.h"
+#include "ring.h"
+#include "ruler.h"
+#include "system.h"
+#include "unclone.h"
+#include "utilities.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+void share_ring_clauses_with_ruler (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct reclone *reclone = &ruler->reclone;
+#ifndef QUIET
+  double start = current_time ();
+#endif
+  assert (!ring->id);
+  assert (!ruler->occurrences);
+  assert (EMPTY (ruler->clauses));
+  assert (ruler->compact == ring->size);
+
+  struct ruler_statistics *statistics = &ruler->statistics;
+  reclone->binaries = statistics->binaries;
+  reclone->removed = statistics->eliminated + statistics->substituted;
+
+  ruler->occurrences =
+      allocate_and_clear_array (2 * ring->size, sizeof *ruler->occurrences);
+  for (all_ring_literals (lit)) {
+    unsigned *binaries = BINARIES (lit);
+    if (!binaries)
+      continue;
+    struct clauses *occurrences = &OCCURRENCES (lit);
+    for (unsigned *p = binaries, other; (other = *p) != INVALID; p++) {
+      struct clause *clause = tag_binary (false, lit, other);
+      PUSH (*occurrences, clause);
+    }
+  }
+
+#ifndef QUIET
+  size_t shared = 0;
+#endif
+  struct watcher *begin = ring->watchers.begin + 1;
+  struct watcher *end = ring->watchers.begin + ring->redundant;
+  for (struct watcher *watcher = begin; watcher != end; watcher++) {
+    assert (!watcher->redundant);
+    struct clause *clause = watcher->clause;
+    if (clause->garbage)
+      continue;
+    clause->vivified = false; // Tried again after simplification.
+    reference_clause (ring, clause, 1);
+    PUSH (ruler->clauses, clause);
+#ifndef QUIET
+    shared++;
+#endif
+  }
+  very_verbose (ring,
+                "shared %" PRIu64 " binary and %zu large clauses with ruler",
+                reclone->binaries, shared);
+#ifndef QUIET
+  reclone->current = current_time () - start;
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool incremental_recloning (struct ruler *ruler) {
+  unsigned limit = ruler->options.simplify_incremental;
+  if (!limit)
+    return false;
+  if (ruler->inconsistent)
+    return false;
+  if (ruler->terminate)
+    return false;
+  struct ruler_statistics *statistics = &ruler->statistics;
+  struct reclone *reclone = &ruler->reclone;
+  uint64_t removed = statistics->eliminated + statistics->substituted;
+  if (removed != reclone->removed) {
+    verbose (0, "full re-cloning since %" PRIu64 " variables were removed",
+             removed - reclone->removed);
+    return false;
+  }
+  size_t fixed = SIZE (ruler->units);
+  if (100.0 * fixed > (double) limit * ruler->compact) {
+    verbose (0, "full re-cloning since %zu variables %.0f%% were fixed",
+             fixed, percent (fixed, ruler->compact));
+    return false;
+  }
+  verbose (0, "incremental re-cloning with %zu fixed variables %.0f%%",
+           fixed, percent (fixed, ruler->compact));
+  return true;
+}
+
+static bool same_binaries (unsigned *binaries, struct clauses *occurrences) {
+  unsigned *p = binaries;
+  for (all_clauses (clause, *occurrences)) {
+    if (!is_binary_pointer (clause))
+      continue;
+    if (!p || *p++ != other_pointer (clause))
+      return false;
+  }
+  return !p || *p == INVALID;
+}
+
+static void replace_changed_binaries (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct reclone *reclone = &ruler->reclone;
+  assert (EMPTY (reclone->changed));
+  for (all_ring_literals (lit)) {
+    struct clauses *occurrences = &OCCURRENCES (lit);
+    unsigned *binaries = BINARIES (lit);
+    if (!same_binaries (binaries, occurrences)) {
+      size_t size = SIZE (*occurrences);
+      unsigned *b = allocate_array (size + 1, sizeof *b);
+      BINARIES (lit) = b;
+      for (all_clauses (clause, *occurrences))
+        if (is_binary_pointer (clause))
+          *b++ = other_pointer (clause);
+      *b = INVALID;
+      free (binaries);
+      PUSH (reclone->changed, lit);
+    }
+    RELEASE (*occurrences);
+  }
+  free (ruler->occurrences);
+  ruler->occurrences = 0;
+  very_verbose (ring, "replaced binary clauses of %zu literals",
+                SIZE (reclone->changed));
+}
+
+static void reference_added_clauses (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct reclone *reclone = &ruler->reclone;
+  assert (EMPTY (reclone->added));
+  unsigned rings = SIZE (ruler->rings);
+  for (all_clauses (clause, ruler->clauses)) {
+    if (clause->garbage)
+      continue;
+    if (atomic_load (&clause->shared))
+      continue;
+    reference_clause (ring, clause, rings);
+    PUSH (reclone->added, clause);
+  }
+  very_verbose (ring, "adding %zu large clauses to all rings",
+                SIZE (reclone->added));
+}
+
+void prepare_recloning (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct reclone *reclone = &ruler->reclone;
+#ifndef QUIET
+  reclone->current -= current_time ();
+#endif
+  assert (!ring->id);
+  reclone->incremental = incremental_recloning (ruler);
+  if (!reclone->incremental)
+    return;
+  ruler->statistics.reclone.incremental++;
+  replace_changed_binaries (ring);
+  compress_ruler_clauses (ruler);
+  reference_added_clauses (ring);
+}
+
+/*------------------------------------------------------------------------*/
+
+static size_t mark_garbage_irredundant_watchers (struct ring *ring) {
+  size_t marked = 0;
+  struct watcher *begin = ring->watchers.begin + 1;
+  struct watcher *end = ring->watchers.begin + ring->redundant;
+  for (struct watcher *watcher = begin; watcher != end; watcher++) {
+    if (watcher->garbage)
+      continue;
+    if (!watcher->clause->garbage)
+      continue;
+    mark_garbage_watcher (ring, watcher);
+    marked++;
+  }
+  return marked;
+}
+
+static void remap_watches (struct ring *ring, unsigned *map,
+                           unsigned redundant, unsigned delta) {
+  for (all_ring_literals (lit)) {
+    struct references *watches = &REFERENCES (lit);
+    struct watch **begin = watches->begin, **q = begin;
+    struct watch **end = watches->end;
+    for (struct watch **p = begin; p != end; p++) {
+      struct watch *watch = *p;
+      if (!is_binary_pointer (watch)) {
+        unsigned dst = map[index_pointer (watch) - 1];
+        if (!dst)
+          continue;
+        if (dst >= redundant)
+          dst += delta;
+        unsigned other = other_pointer (watch);
+        watch = tag_index (redundant_pointer (watch), dst, other);
+      }
+      *q++ = watch;
+    }
+    watches->end = q;
+  }
+}
+
+// New irredundant watchers have to be placed before the redundant ones.
+// Thus the garbage watchers are flushed and the redundant watchers are
+// moved up, which requires to remap the watch lists.
+
+static void watch_added_clauses (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct clauses *added = &ruler->reclone.added;
+  forward_all_references (ring);
+  unsigned *map = flush_watchers (ring, 1);
+  unsigned redundant = ring->redundant;
+  unsigned delta = SIZE (*added);
+  remap_watches (ring, map, redundant, delta);
+  clear_segments (ring);
+  free (map);
+
+  struct watchers *watchers = &ring->watchers;
+  size_t moved = SIZE (*watchers) - redundant;
+  struct watcher *saved = allocate_array (moved, sizeof *saved);
+  if (moved)
+    memcpy (saved, watchers->begin + redundant, moved * sizeof *saved);
+  watchers->end = watchers->begin + redundant;
+  for (all_clauses (clause, *added))
+    (void) watch_first_two_literals_in_large_clause (ring, clause);
+  assert (SIZE (*watchers) == redundant + delta);
+  for (size_t i = 0; i != moved; i++)
+    PUSH (*watchers, saved[i]);
+  free (saved);
+
+  ring->redundant = redundant + delta;
+  reset_last_learned (ring);
+  very_verbose (ring, "redundant clauses start at watcher index %u",
+                ring->redundant);
+}
+
+static void assign_ruler_units (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  signed char *values = ring->values;
+  while (!ring->inconsistent && ring->ruler_units != ruler->units.end) {
+    unsigned unit = *ring->ruler_units++;
+    signed char value = values[unit];
+    if (value > 0)
+      continue;
+    if (value < 0)
+      set_inconsistent (ring, "simplification falsified unit");
+    else
+      assign_ring_unit (ring, unit);
+  }
+}
+
+static void patch_ring (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct reclone *reclone = &ruler->reclone;
+  struct ring_statistics *statistics = &ring->statistics;
+  assert (statistics->irredundant >= reclone->binaries);
+  statistics->irredundant -= reclone->binaries;
+  statistics->irredundant += ruler->statistics.binaries;
+  size_t garbage = mark_garbage_irredundant_watchers (ring);
+  if (!EMPTY (reclone->added))
+    watch_added_clauses (ring);
+  else if (garbage) {
+    // Forces the next reduction to flush irredundant watchers too.
+    ring->last.fixed = INVALID;
+  }
+  assign_ruler_units (ring);
+  very_verbose (ring,
+                "patched %zu binary literals, %zu garbage and "
+                "%zu added large clauses",
+                SIZE (reclone->changed), garbage, SIZE (reclone->added));
+}
+
+void reclone_ring (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  if (ruler->reclone.incremental)
+    patch_ring (ring);
+  else
+    unclone_ring (ring);
+}
+
+/*------------------------------------------------------------------------*/
+
+void finish_recloning (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct reclone *reclone = &ruler->reclone;
+  assert (!ring->id);
+  if (reclone->incremental) {
+    for (all_clauses (clause, ruler->clauses))
+      (void) dereference_ruler_clause (ruler, clause);
+    CLEAR (reclone->changed);
+    CLEAR (reclone->added);
+  } else
+    ruler->statistics.reclone.full++;
+  RELEASE (ruler->clauses);
+#ifndef QUIET
+  double time = reclone->current + current_time ();
+  if (reclone->incremental)
+    reclone->time.incremental += time;
+  else
+    reclone->time.full += time;
+  message (0, "%s re-cloning took %.2f seconds",
+           reclone->incremental ? "incremental" : "full", time);
+#endif
+}
+
+void release_recloning (struct reclone *reclone) {
+  RELEASE (reclone->changed);
+  RELEASE (reclone->added);
+}
@@ -0,0 +1,49 @@
+#ifndef _reclone_h_INCLUDED
+#define _reclone_h_INCLUDED
+
+#include "clause.h"
+#include "stack.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct ring;
+
+// During synchronized simplification the first ring only shares its
+// irredundant clauses with the ruler, which copies the binary clauses
+// into its occurrence lists and takes an additional reference to each
+// large clause.  All rings keep their watches.  The ruler does not change
+// shared clauses in place but copies them instead (see
+// 'unshare_ruler_clause').  If afterwards neither variables have been
+// eliminated nor substituted and only a few variables have been fixed
+// since the last compaction, the rings are patched incrementally: binary
+// clause arrays are replaced only for literals with changed binary
+// clauses, watchers of large clauses which became garbage are marked and
+// new large clauses are watched.  Otherwise all rings are uncloned, the
+// ruler compacted and the rings copied from the ruler (see 'clone.c').
+// Patching still scans all literals and remaps all watchers of a ring,
+// which is as expensive as copying, and thus is disabled by default
+// ('--simplify-incremental=0').
+
+struct reclone {
+  bool copying;
+  bool incremental;
+  uint64_t binaries;
+  uint64_t removed;
+  struct unsigneds changed;
+  struct clauses added;
+#ifndef QUIET
+  double current;
+  struct {
+    double full, incremental;
+  } time;
+#endif
+};
+
+void share_ring_clauses_with_ruler (struct ring *);
+void prepare_recloning (struct ring *);
+void reclone_ring (struct ring *);
+void finish_recloning (struct ring *);
+void release_recloning (struct reclone *);
+
+#endif
@@ -36,7 +36,7 @@ void check_clause_statistics (struct ring *ring) {
         redundant++;
       }
 
-      unsigned *binaries = watches->binaries;
+      unsigned *binaries = BINARIES (lit);
       if (!binaries)
         continue;
       for (unsigned *p = binaries, other; (other = *p) != INVALID; p++)
@@ -122,11 +122,13 @@ static void unmark_reasons (struct ring *ring, unsigned start,
     unsigned src = index_pointer (watch);
     if (src < start)
       continue;
-    unsigned dst = map_idx (src, start, map);
+    unsigned dst = map ? map_idx (src, start, map) : src;
     assert (dst);
     struct watcher *watcher = index_to_watcher (ring, dst);
     assert (watcher->reason);
     watcher->reason = false;
+    if (!map)
+      continue;
     bool redundant = redundant_pointer (watch);
     unsigned other = other_pointer (watch);
     struct watch *mapped = tag_index (redundant, dst, other);
@@ -134,35 +136,111 @@ static void unmark_reasons (struct ring *ring, unsigned start,
   }
 }
 
+void clear_segments (struct ring *ring) {
+  struct segments *segments = &ring->segments;
+  for (unsigned tier = 0; tier != 3; tier++)
+    CLEAR (segments->tier[tier]);
+  segments->segmented = 0;
+}
+
+void release_segments (struct ring *ring) {
+  struct segments *segments = &ring->segments;
+  for (unsigned tier = 0; tier != 3; tier++)
+    RELEASE (segments->tier[tier]);
+}
+
+static unsigned glue_tier (struct ring *ring, unsigned glue) {
+  if (glue <= ring->tier1_glue_limit[ring->stable])
+    return 0;
+  if (glue <= ring->tier2_glue_limit[ring->stable])
+    return 1;
+  return 2;
+}
+
+static void segment_new_watchers (struct ring *ring) {
+  struct segments *segments = &ring->segments;
+  unsigned start = MAX (segments->segmented, ring->redundant);
+  unsigned end = SIZE (ring->watchers);
+  for (unsigned idx = start; idx < end; idx++) {
+    struct watcher *watcher = index_to_watcher (ring, idx);
+    assert (watcher->redundant);
+    if (watcher->garbage)
+      continue;
+    unsigned tier = glue_tier (ring, watcher->glue);
+    PUSH (segments->tier[tier], idx);
+  }
+  segments->segmented = end;
+}
+
 static void gather_reduce_candidates (struct ring *ring,
                                       struct unsigneds *candidates) {
-  struct watchers *watchers = &ring->watchers;
-  struct watcher *begin = watchers->begin;
-  struct watcher *end = watchers->end;
-  struct watcher *redundant = begin + ring->redundant;
+  segment_new_watchers (ring);
+  struct segments *segments = &ring->segments;
   unsigned tier1 = ring->tier1_glue_limit[ring->stable];
   unsigned tier2 = ring->tier2_glue_limit[ring->stable];
-  for (struct watcher *watcher = redundant; watcher != end; watcher++) {
-    if (!watcher->redundant)
-      continue;
-    if (watcher->garbage)
-      continue;
-    const unsigned char used = watcher->used;
-    if (used)
-      watcher->used = used - 1;
-    if (watcher->reason)
-      continue;
-    const unsigned char glue = watcher->glue;
-    if (glue <= tier1 && used)
-      continue;
-    if (glue <= tier2 && used >= MAX_USED - 1)
-      continue;
-    unsigned idx = watcher_to_index (ring, watcher);
-    PUSH (*candidates, idx);
+  bool aging = !(ring->statistics.reductions % TIER1_AGING);
+  struct unsigneds moved;
+  INIT (moved);
+  size_t visited = 0;
+  for (unsigned tier = !aging; tier != 3; tier++) {
+    struct unsigneds *segment = segments->tier + tier;
+    unsigned *begin = segment->begin, *q = begin;
+    unsigned *end = segment->end;
+    visited += end - begin;
+    for (unsigned *p = begin; p != end; p++) {
+      unsigned idx = *p;
+      struct watcher *watcher = index_to_watcher (ring, idx);
+      assert (watcher->redundant);
+      if (watcher->garbage)
+        continue;
+      const unsigned char used = watcher->used;
+      if (used && tier)
+        watcher->used = used - 1;
+      else if (used)
+        watcher->used = used > TIER1_AGING ? used - TIER1_AGING : 0;
+      const unsigned char glue = watcher->glue;
+      if (glue_tier (ring, glue) == tier)
+        *q++ = idx;
+      else
+        PUSH (moved, idx);
+      if (watcher->reason)
+        continue;
+      if (glue <= tier1 && used)
+        continue;
+      if (glue <= tier2 && used >= MAX_USED - 1)
+        continue;
+      PUSH (*candidates, idx);
+    }
+    segment->end = q;
+  }
+  for (all_elements_on_stack (unsigned, idx, moved)) {
+    struct watcher *watcher = index_to_watcher (ring, idx);
+    unsigned tier = glue_tier (ring, watcher->glue);
+    PUSH (segments->tier[tier], idx);
   }
-  verbose (ring, "gathered %zu reduce candidates %.0f%%",
+  RELEASE (moved);
+  ring->statistics.reduced.visited += visited;
+  verbose (ring, "gathered %zu reduce candidates %.0f%% visiting %zu",
            SIZE (*candidates),
-           percent (SIZE (*candidates), ring->statistics.redundant));
+           percent (SIZE (*candidates), ring->statistics.redundant),
+           visited);
+}
+
+static void map_segments (struct ring *ring, unsigned start,
+                          unsigned *map) {
+  struct segments *segments = &ring->segments;
+  for (unsigned tier = 0; tier != 3; tier++) {
+    struct unsigneds *segment = segments->tier + tier;
+    unsigned *begin = segment->begin, *q = begin;
+    unsigned *end = segment->end;
+    for (unsigned *p = begin; p != end; p++) {
+      unsigned dst = map_idx (*p, start, map);
+      if (dst)
+        *q++ = dst;
+    }
+    segment->end = q;
+  }
+  segments->segmented = SIZE (ring->watchers);
 }
 
 static void
@@ -253,18 +331,38 @@ static void flush_references (struct ring *ring, bool fixed, unsigned start,
     watches->end = q;
     SHRINK_STACK (*watches);
   }
-  assert (!(flushed & 1));
   verbose (ring, "flushed %zu garbage watches from watch lists", flushed);
 }
 
+// Flushing garbage watchers requires to rewrite the watch lists of all
+// literals (either eagerly or lazily through forwarding).  Unless new
+// root-level units have to be removed the garbage watchers are therefore
+// only flushed if they make up a large enough fraction of all watchers.
+// Otherwise they stay marked and their watches are dropped during
+// propagation when they are encountered.
+
+static bool flushing_garbage (struct ring *ring) {
+  unsigned limit = ring->options.reduce_garbage;
+  size_t size = SIZE (ring->watchers);
+  bool res = 100.0 * ring->garbage >= (double) limit * size;
+  very_verbose (ring, "%s %u garbage watchers %.0f%% (limit %u%%)",
+                res ? "flushing" : "keeping", ring->garbage,
+                percent (ring->garbage, size), limit);
+  return res;
+}
+
 void reduce (struct ring *ring) {
-  START (ring, reduce);
+#ifndef QUIET
+  double start_reduce = START (ring, reduce);
+#endif
   check_clause_statistics (ring);
   check_redundant_offset (ring);
   recalculate_tier_limits (ring);
   struct ring_statistics *statistics = &ring->statistics;
   struct ring_limits *limits = &ring->limits;
   statistics->reductions++;
+  size_t watchers = SIZE (ring->watchers) - ring->redundant;
+  statistics->reduced.watchers += watchers;
   verbose (ring, "reduction %" PRIu64 " at %" PRIu64 " conflicts",
            statistics->reductions, SEARCH_CONFLICTS);
   bool fixed = ring->last.fixed != ring->statistics.fixed;
@@ -281,11 +379,20 @@ void reduce (struct ring *ring) {
                                   candidates.begin);
   mark_reduce_candidates_as_garbage (ring, &candidates);
   RELEASE (candidates);
-  unsigned *map = flush_watchers (ring, start);
-  unmark_reasons (ring, start, map);
-  flush_references (ring, fixed, start, map);
-  free (map);
-  reset_last_learned (ring);
+  if (fixed || flushing_garbage (ring)) {
+    forward_all_references (ring);
+    unsigned *map = flush_watchers (ring, start);
+    unmark_reasons (ring, start, map);
+    map_segments (ring, start, map);
+    if (fixed || !ring->options.reduce_forward) {
+      flush_references (ring, fixed, start, map);
+      free (map);
+    } else
+      install_forwarding (ring, start, map);
+    reset_last_learned (ring);
+    statistics->reduced.flushed++;
+  } else
+    unmark_reasons (ring, start, 0);
   check_clause_statistics (ring);
   check_redundant_offset (ring);
   limits->reduce = SEARCH_CONFLICTS;
@@ -297,5 +404,16 @@ void reduce (struct ring *ring) {
       ring, "next reduce limit at %" PRIu64 " after %" PRIu64 " conflicts",
       limits->reduce, delta);
   report (ring, '-');
-  STOP (ring, reduce);
+#ifndef QUIET
+  double end_reduce = STOP (ring, reduce);
+  unsigned bucket = 0;
+  for (size_t size = watchers; size > 1; size >>= 1)
+    bucket++;
+  if (bucket >= SIZE_REDUCE_STATISTICS)
+    bucket = SIZE_REDUCE_STATISTICS - 1;
+  statistics->reduce_by_size[bucket].count++;
+  statistics->reduce_by_size[bucket].time += end_reduce - start_reduce;
+#else
+  (void) watchers;
+#endif
 }
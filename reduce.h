@@ -1,11 +1,30 @@
 #ifndef _reduce_h_INCLUDED
 #define _reduce_h_INCLUDED
 
+#include "stack.h"
+
 #include <stdbool.h>
 
+// The indices of redundant watchers are kept in segments by tier.  New
+// watchers are segmented lazily during the next reduction (all watchers
+// starting at 'segmented').  Reduction only visits the tier2 and tier3
+// segments, while tier1 watchers are aged and checked only every
+// 'TIER1_AGING' reductions.  Watchers which moved to another tier (their
+// glue was promoted or the tier limits changed) are moved to the proper
+// segment when visited and garbage watchers are removed.
+
+#define TIER1_AGING 4
+
+struct segments {
+  unsigned segmented;
+  struct unsigneds tier[3];
+};
+
 struct ring;
 bool reducing (struct ring *);
 void reduce (struct ring *);
 void recalculate_tier_limits (struct ring *);
+void clear_segments (struct ring *);
+void release_segments (struct ring *);
 
 #endif
@@ -4,6 +4,7 @@
 #include "message.h"
 #include "report.h"
 #include "ring.h"
+#include "ruler.h"
 #include "search.h"
 #include "utilities.h"
 #include "walk.h"
@@ -11,7 +12,10 @@
 #include <inttypes.h>
 
 static char rephase_walk (struct ring *ring) {
-  local_search (ring);
+  if (ring->ruler->walkers)
+    (void) adopt_walked_phases (ring);
+  else
+    local_search (ring);
   for (all_phases (p))
     p->target = p->saved;
   return 'W';
@@ -51,6 +55,8 @@ void rephase (struct ring *ring) {
     return;
   struct ring_statistics *statistics = &ring->statistics;
   struct ring_limits *limits = &ring->limits;
+  if (ring->ruler->walkers)
+    publish_target_phases (ring);
   uint64_t rephased = ++statistics->rephased;
   size_t size_schedule = sizeof schedule / sizeof *schedule;
   char type = schedule[rephased % size_schedule](ring);
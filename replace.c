@@ -0,0 +1,118 @@
+#include "replace.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define VECTORIZE
+#include <immintrin.h>
+#endif
+
+static unsigned *find_replacement_portable (const signed char *values,
+                                            unsigned *begin, unsigned *end,
+                                            unsigned not_lit,
+                                            unsigned other) {
+  for (unsigned *p = begin; p != end; p++) {
+    unsigned lit = *p;
+    if (lit != not_lit && lit != other && values[lit] >= 0)
+      return p;
+  }
+  return end;
+}
+
+#ifdef VECTORIZE
+
+// The gathered 32-bit words contain the value of the literal in their
+// least significant byte.  Shifting it to the most significant byte makes
+// the word negative if and only if the literal is false.
+
+__attribute__ ((target ("avx2"))) static unsigned *
+find_replacement_avx2 (const signed char *values, unsigned *begin,
+                       unsigned *end, unsigned not_lit, unsigned other) {
+  const __m256i not_lits = _mm256_set1_epi32 ((int) not_lit);
+  const __m256i others = _mm256_set1_epi32 ((int) other);
+  const __m256i minus_one = _mm256_set1_epi32 (-1);
+  const int *base = (const int *) values;
+  unsigned *p = begin;
+  while (end - p >= 8) {
+    __m256i lits = _mm256_loadu_si256 ((const __m256i *) p);
+    __m256i words = _mm256_i32gather_epi32 (base, lits, 1);
+    __m256i shifted = _mm256_slli_epi32 (words, 24);
+    __m256i candidates = _mm256_cmpgt_epi32 (shifted, minus_one);
+    __m256i excluded = _mm256_or_si256 (_mm256_cmpeq_epi32 (lits, not_lits),
+                                        _mm256_cmpeq_epi32 (lits, others));
+    candidates = _mm256_andnot_si256 (excluded, candidates);
+    int mask = _mm256_movemask_ps (_mm256_castsi256_ps (candidates));
+    if (mask)
+      return p + __builtin_ctz ((unsigned) mask);
+    p += 8;
+  }
+  return find_replacement_portable (values, p, end, not_lit, other);
+}
+
+__attribute__ ((target ("avx512f,avx2"))) static unsigned *
+find_replacement_avx512 (const signed char *values, unsigned *begin,
+                         unsigned *end, unsigned not_lit, unsigned other) {
+  const __m512i not_lits = _mm512_set1_epi32 ((int) not_lit);
+  const __m512i others = _mm512_set1_epi32 ((int) other);
+  const __m512i zero = _mm512_setzero_si512 ();
+  unsigned *p = begin;
+  while (end - p >= 16) {
+    __m512i lits = _mm512_loadu_si512 ((const void *) p);
+    __m512i words = _mm512_i32gather_epi32 (lits, (const void *) values, 1);
+    __m512i shifted = _mm512_slli_epi32 (words, 24);
+    __mmask16 mask = _mm512_cmpge_epi32_mask (shifted, zero);
+    mask &= _mm512_cmpneq_epi32_mask (lits, not_lits);
+    mask &= _mm512_cmpneq_epi32_mask (lits, others);
+    if (mask)
+      return p + __builtin_ctz ((unsigned) mask);
+    p += 16;
+  }
+  return find_replacement_avx2 (values, p, end, not_lit, other);
+}
+
+#endif
+
+// The kernels are ordered by speed.  On long clauses the AVX-512 kernel
+// was measured to be 1.28 to 1.70 times faster than the portable one and
+// the AVX2 kernel only 1.03 to 1.36 times (see 'bench/replace.c').  Thus
+// the widest supported kernel is picked by default.  As the gain depends
+// on the machine, a specific kernel can be forced with '--vectorize'.
+
+const struct replacement_kernel replacement_kernels[] = {
+#ifdef VECTORIZE
+    {"avx512", find_replacement_avx512},
+    {"avx2", find_replacement_avx2},
+#endif
+    {"portable", find_replacement_portable},
+    {0, 0},
+};
+
+find_replacement_function *find_replacement = find_replacement_portable;
+
+bool supported_replacement_kernel (const struct replacement_kernel *kernel) {
+#ifdef VECTORIZE
+  __builtin_cpu_init ();
+  if (kernel->find == find_replacement_avx512)
+    return __builtin_cpu_supports ("avx512f") &&
+           __builtin_cpu_supports ("avx2");
+  if (kernel->find == find_replacement_avx2)
+    return __builtin_cpu_supports ("avx2");
+#endif
+  return kernel->find == find_replacement_portable;
+}
+
+static const char *forced_kernel_names[] = {"portable", "avx2", "avx512"};
+
+const char *init_replacement_search (unsigned vectorize) {
+  const char *forced = 0;
+  if (vectorize < sizeof forced_kernel_names / sizeof *forced_kernel_names)
+    forced = forced_kernel_names[vectorize];
+  const struct replacement_kernel *kernel = replacement_kernels;
+  while (kernel->find != find_replacement_portable &&
+         (!supported_replacement_kernel (kernel) ||
+          (forced && strcmp (kernel->name, forced))))
+    kernel++;
+  find_replacement = kernel->find;
+  return kernel->name;
+}
@@ -0,0 +1,39 @@
+#ifndef _replace_h_INCLUDED
+#define _replace_h_INCLUDED
+
+#include <stdbool.h>
+
+// The search for a replacement literal in long clauses during propagation
+// is vectorized on x86-64 machines supporting AVX2 or AVX-512.  The kernels
+// gather the values of eight respectively sixteen literals at once.  Since
+// gathering uses 32-bit loads at the byte offset of the literal in the
+// values array, that array has to be padded by 'VALUES_PADDING' bytes.
+// The kernel is selected at run-time through CPU feature detection with a
+// portable fallback, which is also used if vectorization is disabled or
+// the kernel forced by '--vectorize' is not supported.
+
+#define VALUES_PADDING 3
+#define MIN_VECTORIZED_CLAUSE_SIZE 16
+
+// Returns a pointer to the first literal in '[begin, end)' which is not
+// false and different from 'not_lit' and 'other' or 'end' if there is no
+// such literal.
+
+typedef unsigned *find_replacement_function (const signed char *values,
+                                             unsigned *begin,
+                                             unsigned *end,
+                                             unsigned not_lit,
+                                             unsigned other);
+
+struct replacement_kernel {
+  const char *name;
+  find_replacement_function *find;
+};
+
+extern const struct replacement_kernel replacement_kernels[];
+extern find_replacement_function *find_replacement;
+
+bool supported_replacement_kernel (const struct replacement_kernel *);
+const char *init_replacement_search (unsigned vectorize);
+
+#endif
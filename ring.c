@@ -2,8 +2,10 @@
 #include "macros.h"
 #include "message.h"
 #include "random.h"
+#include "replace.h"
 #include "ruler.h"
 #include "utilities.h"
+#include "walk.h"
 
 #include <assert.h>
 #include <stdarg.h>
@@ -68,6 +70,19 @@ static void init_ring_profiles (struct ring *ring) {
 
 #endif
 
+#ifdef PACKED_VALUES
+
+void pack_values (struct ring *ring) {
+  signed char *values = ring->values;
+  unsigned char *packed = ring->packed;
+  memset (packed, 0, bytes_packed_values (ring->size));
+  for (all_ring_literals (lit))
+    if (values[lit] > 0)
+      assign_packed_value (packed, lit);
+}
+
+#endif
+
 void init_ring (struct ring *ring) {
   size_t size = ring->size;
   very_verbose (ring, "initializing 'ring[%u]' of size %zu", ring->id,
@@ -80,13 +95,23 @@ void init_ring (struct ring *ring) {
   assert (!ring->used);
 
   ring->marks = allocate_and_clear_block (2 * size);
-  ring->values = allocate_and_clear_block (2 * size);
+  ring->values = allocate_and_clear_huge_array (
+      ring->options.huge_pages, 2 * size + VALUES_PADDING, 1);
+#ifdef PACKED_VALUES
+  if (ring->packed)
+    free (ring->packed);
+  ring->packed = allocate_and_clear_block (bytes_packed_values (size));
+#endif
   ring->inactive = allocate_and_clear_block (size);
   ring->used = allocate_and_clear_array (size, sizeof *ring->used);
 
   assert (!ring->references);
-  ring->references =
-      allocate_and_clear_array (sizeof (struct references), 2 * size);
+  ring->references = allocate_and_clear_huge_array (
+      ring->options.huge_pages, 2 * size, sizeof (struct references));
+  ring->binaries = ring->ruler->binaries;
+  assert (!ring->forward.epochs);
+  ring->forward.epochs = allocate_and_clear_huge_array (
+      ring->options.huge_pages, 2 * size, sizeof *ring->forward.epochs);
 
   for (unsigned stable = 0; stable != 2; stable++)
     ring->tier1_glue_limit[stable] = TIER1_GLUE_LIMIT,
@@ -95,9 +120,11 @@ void init_ring (struct ring *ring) {
   struct ring_trail *trail = &ring->trail;
   assert (!trail->begin);
   assert (!trail->pos);
-  trail->end = trail->begin = allocate_array (size, sizeof *trail->begin);
+  trail->end = trail->begin = allocate_and_clear_huge_array (
+      ring->options.huge_pages, size, sizeof *trail->begin);
   trail->propagate = trail->begin;
-  trail->pos = allocate_array (size, sizeof *trail->pos);
+  trail->pos = allocate_and_clear_huge_array (ring->options.huge_pages,
+                                              size, sizeof *trail->pos);
 
   struct ring_units *units = &ring->ring_units;
   assert (!units->begin);
@@ -105,8 +132,33 @@ void init_ring (struct ring *ring) {
   units->export = units->iterate = units->begin;
 
   assert (!ring->variables);
-  ring->variables =
-      allocate_and_clear_array (size, sizeof *ring->variables);
+  ring->variables = allocate_and_clear_huge_array (
+      ring->options.huge_pages, size, sizeof *ring->variables);
+}
+
+// Memory needed by a ring for each variable, excluding watches, watchers
+// and the irredundant binary clauses shared by all rings.
+
+double ring_bytes_per_variable (void) {
+  struct ring *ring = 0;
+  double res = 0;
+  res += 2 * sizeof *ring->marks;
+  res += 2 * sizeof *ring->values;
+#ifdef PACKED_VALUES
+  res += 2 / 8.0;
+#endif
+  res += sizeof *ring->inactive;
+  res += sizeof *ring->used;
+  res += 2 * sizeof *ring->references;
+  res += 2 * sizeof *ring->forward.epochs;
+  res += sizeof *ring->trail.begin;
+  res += sizeof *ring->trail.pos;
+  res += sizeof *ring->ring_units.begin;
+  res += sizeof *ring->variables;
+  res += sizeof *ring->heap.nodes;
+  res += sizeof *ring->phases;
+  res += sizeof *ring->queue.links;
+  return res;
 }
 
 static void init_watchers (struct ring *ring) {
@@ -129,10 +181,16 @@ void release_ring (struct ring *ring, bool keep_values) {
                 ring->size);
 
   FREE (ring->marks);
-  if (!keep_values)
+  if (!keep_values) {
     FREE (ring->values);
+#ifdef PACKED_VALUES
+    FREE (ring->packed);
+#endif
+  }
   FREE (ring->inactive);
   FREE (ring->used);
+  free ((void *) atomic_exchange (&ring->published, 0));
+  release_walking (ring);
 
   RELEASE (ring->analyzed);
   RELEASE (ring->clause);
@@ -144,6 +202,7 @@ void release_ring (struct ring *ring, bool keep_values) {
   RELEASE (ring->exports);
 
   FREE (ring->references);
+  release_forwarding (ring);
 
   struct ring_trail *trail = &ring->trail;
   free (trail->begin);
@@ -224,13 +283,16 @@ struct ring *new_ring (struct ruler *ruler) {
   init_ring (ring);
 
   struct heap *heap = &ring->heap;
-  heap->nodes = allocate_and_clear_array (size, sizeof *heap->nodes);
+  heap->nodes = allocate_and_clear_huge_array (ring->options.huge_pages,
+                                               size, sizeof *heap->nodes);
   heap->increment = 1;
 
-  ring->phases = allocate_and_clear_array (size, sizeof *ring->phases);
+  ring->phases = allocate_and_clear_huge_array (ring->options.huge_pages,
+                                                size, sizeof *ring->phases);
 
   struct queue *queue = &ring->queue;
-  queue->links = allocate_and_clear_array (size, sizeof *queue->links);
+  queue->links = allocate_and_clear_huge_array (ring->options.huge_pages,
+                                                size, sizeof *queue->links);
 
   activate_variables (ring, size);
 
@@ -255,7 +317,8 @@ struct ring *new_ring (struct ruler *ruler) {
   ring->num_conflicts_at_last_import = ruler->num_conflicts_at_last_import;
 
   // Initial Phases
-  ring->initial_phases = ruler->initial_phases_pointer[ring->id];
+  if (ruler->initial_phases_pointer)
+    ring->initial_phases = ruler->initial_phases_pointer[ring->id];
   /*printf("Initial phases for ring %u:\n", ring->id);
   for (unsigned i = 0; i < ring->ruler->size; ++i) {
     printf("%d ", ring->initial_phases[i]);
@@ -303,8 +366,11 @@ void init_pool (struct ring *ring, unsigned threads) {
   while (b != end) {
     b->shared = 0;
     b->redundancy = MAX_REDUNDANCY;
+    b->exported = 0;
     b++;
   }
+  ring->statistics.sharing.sources = allocate_and_clear_array (
+      threads, sizeof *ring->statistics.sharing.sources);
 }
 
 static void release_pool (struct ring *ring) {
@@ -333,12 +399,13 @@ static void release_pool (struct ring *ring) {
     }
   }
   deallocate_aligned (CACHE_LINE_SIZE, ring->pool);
+  free (ring->statistics.sharing.sources);
 }
 
 static void release_binaries (struct ring *ring) {
-  if (ring->references)
+  if (ring->binaries)
     for (all_ring_literals (lit))
-      free (REFERENCES (lit).binaries);
+      free (BINARIES (lit));
 }
 
 void delete_ring (struct ring *ring) {
@@ -356,6 +423,7 @@ void delete_ring (struct ring *ring) {
   free (ring->queue.links);
 
   release_watchers (ring);
+  release_segments (ring);
   release_saved (ring);
 
   RELEASE (ring->trace.buffer);
@@ -3,12 +3,15 @@
 
 #include "average.h"
 #include "clause.h"
+#include "forward.h"
 #include "heap.h"
 #include "logging.h"
 #include "macros.h"
 #include "options.h"
+#include "packed.h"
 #include "profile.h"
 #include "queue.h"
+#include "reduce.h"
 #include "stack.h"
 #include "statistics.h"
 #include "tagging.h"
@@ -21,12 +24,14 @@
 #include <stdlib.h>
 
 struct ruler;
+struct walking;
 
 struct reluctant {
   uint64_t u, v;
 };
 
 struct ring_limits {
+  uint64_t async;
   uint64_t mode;
   uint64_t randec;
   uint64_t reduce;
@@ -58,6 +63,7 @@ struct averages {
 };
 
 struct ring_last {
+  uint64_t async;
   uint64_t decisions;
   unsigned fixed;
   uint64_t probing;
@@ -99,6 +105,7 @@ struct ring_units {
 struct bucket {
   uint64_t redundancy;
   atomic_uintptr_t shared;
+  double exported;
 };
 
 struct pool {
@@ -115,6 +122,9 @@ struct ring {
   unsigned id;
   unsigned threads;
   struct pool *pool;
+  atomic_uintptr_t published; // phases published to this ring
+  struct walking *walking;     // persistent local search state
+
   unsigned *ruler_units;
   struct ruler *ruler;
 
@@ -123,13 +133,13 @@ struct ring {
   bool import_after_propagation_and_conflict;
   bool inconsistent;
   bool stable;
+  bool walker;
 
   signed char iterating;
 
   unsigned best;
   unsigned context;
   unsigned level;
-  unsigned probe;
   unsigned size;
   unsigned target;
   unsigned unassigned;
@@ -139,6 +149,9 @@ struct ring {
 
   signed char *marks;
   signed char *values;
+#ifdef PACKED_VALUES
+  unsigned char *packed;
+#endif
 
   bool *inactive;
   unsigned char *used;
@@ -153,6 +166,7 @@ struct ring {
   struct rings exports;
 
   struct references *references;
+  unsigned **binaries;
   struct ring_trail trail;
   struct ring_units ring_units;
   struct variable *variables;
@@ -162,8 +176,11 @@ struct ring {
   struct queue queue;
 
   unsigned redundant;
+  unsigned garbage;
   struct watchers watchers;
   unsigned last_learned[4];
+  struct segments segments;
+  struct forward forward;
   struct saved_watchers saved;
 
   struct trace trace;
@@ -200,6 +217,7 @@ struct ring {
 
 #define VAR(LIT) (ring->variables + IDX (LIT))
 #define REFERENCES(LIT) (ring->references[LIT])
+#define BINARIES(LIT) (ring->binaries[LIT])
 
 /*------------------------------------------------------------------------*/
 
@@ -251,6 +269,7 @@ struct ring {
 /*------------------------------------------------------------------------*/
 
 void init_ring (struct ring *);
+double ring_bytes_per_variable (void);
 void release_ring (struct ring *, bool keep_values);
 
 struct ring *new_ring (struct ruler *);
@@ -268,6 +287,7 @@ void dec_clauses (struct ring *ring, bool redundant);
 void set_inconsistent (struct ring *, const char *msg);
 void set_satisfied (struct ring *);
 
+double flush_ring_profiles (struct ring *);
 void print_ring_profiles (struct ring *);
 
 unsigned *sorter_block (struct ring *, size_t size);
@@ -306,9 +326,16 @@ static inline struct clause *get_clause (struct ring *ring,
 
 /*------------------------------------------------------------------------*/
 
+static inline void forward_watches (struct ring *ring, unsigned lit) {
+  struct forward *forward = &ring->forward;
+  if (forward->epochs[lit] != forward->epoch)
+    forward_references (ring, lit);
+}
+
 static inline void push_watch (struct ring *ring, unsigned lit,
                                struct watch *watch) {
   LOGWATCH (watch, "watching %s in", LOGLIT (lit));
+  forward_watches (ring, lit);
   PUSH (REFERENCES (lit), watch);
 }
 
@@ -1,9 +1,11 @@
 #include "ruler.h"
 #include "message.h"
 #include "pthread.h"
+#include "replace.h"
 #include "simplify.h"
 #include "trace.h"
 #include "utilities.h"
+#include "walk.h"
 
 #include <string.h>
 
@@ -44,6 +46,8 @@ struct ruler *new_ruler (size_t size, struct options *opts) {
   ruler->occurrences =
       allocate_and_clear_array (2 * size, sizeof *ruler->occurrences);
   ruler->values = allocate_and_clear_block (2 * size);
+  ruler->binaries =
+      allocate_and_clear_array (2 * size, sizeof *ruler->binaries);
 
   ruler->mallob_import_clause = allocate_and_clear_block (sizeof (struct unsigneds));
   INIT (*(ruler->mallob_import_clause));
@@ -53,6 +57,7 @@ struct ruler *new_ruler (size_t size, struct options *opts) {
 #ifndef NDEBUG
   ruler->original = allocate_and_clear_block (sizeof *ruler->original);
 #endif
+  init_probing (&ruler->probing, size);
   ruler->units.begin = allocate_array (size, sizeof (unsigned));
   ruler->units.propagate = ruler->units.end = ruler->units.begin;
 
@@ -60,6 +65,9 @@ struct ruler *new_ruler (size_t size, struct options *opts) {
   ruler->trace.file = opts->proof.file ? &opts->proof : 0;
 
   memcpy (&ruler->options, opts, sizeof *opts);
+  const char *kernel = init_replacement_search (opts->vectorize);
+  verbose (0, "using %s replacement search kernel", kernel);
+  (void) kernel;
 #ifndef QUIET
   init_ruler_profiles (ruler);
 #endif
@@ -81,7 +89,7 @@ static void release_occurrences (struct ruler *ruler) {
 static void release_clauses (struct ruler *ruler) {
   for (all_clauses (clause, ruler->clauses))
     if (!is_binary_pointer (clause))
-      free (clause);
+      (void) dereference_ruler_clause (ruler, clause);
   RELEASE (ruler->clauses);
 }
 
@@ -94,7 +102,18 @@ static void release_original (struct ruler *ruler) {
 
 #endif
 
+static void release_barriers (struct ruler *ruler) {
+#define BARRIER(NAME) release_barrier (&ruler->barriers.NAME);
+  BARRIERS
+#undef BARRIER
+}
+
 void delete_ruler (struct ruler *ruler) {
+  release_asynchronous_simplification (ruler);
+  release_probing (&ruler->probing);
+  release_recloning (&ruler->reclone);
+  release_flat_clauses (ruler);
+  release_barriers (ruler);
   free (ruler->eliminate);
   free (ruler->subsume);
 
@@ -103,6 +122,7 @@ void delete_ruler (struct ruler *ruler) {
   free (ruler->unmap);
   free (ruler->map);
   free ((void *) ruler->values);
+  free (ruler->binaries);
 
   release_clauses (ruler);
   RELEASE (ruler->extension[0]);
@@ -194,6 +214,102 @@ void connect_large_clause (struct ruler *ruler, struct clause *clause) {
     connect_literal (ruler, lit, clause);
 }
 
+// With rings still watching the irredundant clauses during simplification
+// (see 'reclone.h') the ruler only holds an additional reference to large
+// clauses and thus only dereferences them instead of deleting them.
+
+bool dereference_ruler_clause (struct ruler *ruler, struct clause *clause) {
+  assert (!is_binary_pointer (clause));
+  unsigned shared = atomic_fetch_sub (&clause->shared, 1);
+  ROGCLAUSE (clause, "dereference once (was shared %u)", shared);
+  assert (shared + 1);
+  if (shared)
+    return false;
+  free (clause);
+  return true;
+}
+
+// Shared clauses are still watched by the rings and thus can not be
+// changed in place.  Such a clause is copied instead and the copy replaces
+// the original in the occurrence lists.  The original becomes garbage and
+// is flushed by the rings, without tracing its deletion though, since the
+// copy takes over its role in the proof.  Compressed clauses are copied
+// too, even if not shared, since only uncompressed clauses can be changed.
+
+struct clause *unshare_ruler_clause (struct ruler *ruler,
+                                     struct clause *clause) {
+  assert (!is_binary_pointer (clause));
+  assert (!clause->garbage);
+  bool shared = atomic_load (&clause->shared);
+  if (!shared && !clause->compressed)
+    return clause;
+  struct clause *copy;
+  if (clause->compressed) {
+    struct unsigneds literals;
+    INIT (literals);
+    decompress_literals (clause, &literals);
+    copy = new_large_clause (clause->size, literals.begin, false, 0);
+    RELEASE (literals);
+  } else
+    copy = new_large_clause (clause->size, clause->literals, false, 0);
+  copy->dirty = clause->dirty;
+  copy->subsume = clause->subsume;
+  ROGCLAUSE (clause, "unsharing");
+  for (all_literals_in_clause (lit, clause)) {
+    struct clauses *clauses = &OCCURRENCES (lit);
+    for (struct clause **p = clauses->begin; p != clauses->end; p++)
+      if (*p == clause) {
+        *p = copy;
+        break;
+      }
+  }
+  clause->garbage = true;
+  if (shared)
+    ruler->statistics.reclone.unshared++;
+  return copy;
+}
+
+// Compressing long irredundant clauses (see 'clause.h') happens right
+// before the rings start to watch them, since they are only read until
+// the next simplification.  Clauses already shared are skipped.
+
+void compress_ruler_clauses (struct ruler *ruler) {
+  unsigned limit = ruler->options.compress_clauses;
+  if (!limit)
+    return;
+  if (limit <= COMPRESSED_HEAD_SIZE)
+    limit = COMPRESSED_HEAD_SIZE + 1;
+  struct ruler_statistics *statistics = &ruler->statistics;
+  size_t compressed = 0, saved = 0;
+  struct clause **begin = ruler->clauses.begin;
+  struct clause **end = ruler->clauses.end;
+  for (struct clause **p = begin; p != end; p++) {
+    struct clause *clause = *p;
+    if (clause->compressed || clause->garbage)
+      continue;
+    if (clause->size < limit)
+      continue;
+    if (atomic_load (&clause->shared))
+      continue;
+    unsigned size = clause->size;
+    struct clause *res = compress_clause (clause);
+    if (res == clause)
+      continue;
+    *p = res;
+    size_t bytes = bytes_of_clause_literals (res);
+    size_t uncompressed = size * sizeof (unsigned);
+    assert (bytes < uncompressed);
+    statistics->compressed.clauses++;
+    statistics->compressed.literals += size;
+    statistics->compressed.bytes += bytes;
+    statistics->compressed.saved += uncompressed - bytes;
+    saved += uncompressed - bytes;
+    compressed++;
+  }
+  verbose (0, "compressed %zu large clauses saving %zu bytes", compressed,
+           saved);
+}
+
 void assign_ruler_unit (struct ruler *ruler, unsigned unit) {
   signed char *values = (signed char *) ruler->values;
   unsigned not_unit = NOT (unit);
@@ -293,7 +409,7 @@ void set_terminate (struct ruler *ruler, struct ring *ring) {
 
   abort_waiting_and_disable_barrier (&ruler->barriers.start);
   abort_waiting_and_disable_barrier (&ruler->barriers.import);
-  abort_waiting_and_disable_barrier (&ruler->barriers.unclone);
+  abort_waiting_and_disable_barrier (&ruler->barriers.share);
 
   if (terminated)
     return;
@@ -1,11 +1,16 @@
 #ifndef _ruler_h_INCLUDED
 #define _ruler_h_INCLUDED
 
+#include "async.h"
 #include "barrier.h"
 #include "clause.h"
+#include "fail.h"
+#include "monitor.h"
 #include "options.h"
 #include "profile.h"
+#include "reclone.h"
 #include "ring.h"
+#include "sample.h"
 #include "stack.h"
 
 #include <pthread.h>
@@ -13,6 +18,8 @@
 #include <stdint.h>
 #include <stdatomic.h>
 
+struct flat_clauses;
+
 struct ruler_trail {
   unsigned *begin;
   unsigned *propagate;
@@ -20,10 +27,12 @@ struct ruler_trail {
 };
 
 #define LOCKS \
+  LOCK (async) \
   LOCK (rings) \
   LOCK (simplify) \
   LOCK (terminate) \
   LOCK (units) \
+  LOCK (walk) \
   LOCK (winner)
 
 struct ruler_locks {
@@ -33,12 +42,15 @@ struct ruler_locks {
 };
 
 #define BARRIERS \
+  BARRIER (attach) \
+  BARRIER (compact) \
   BARRIER (copy) \
   BARRIER (end) \
   BARRIER (import) \
+  BARRIER (reclone) \
   BARRIER (run) \
-  BARRIER (start) \
-  BARRIER (unclone)
+  BARRIER (share) \
+  BARRIER (start)
 
 struct ruler_barriers {
 #define BARRIER(NAME) struct barrier NAME;
@@ -69,6 +81,7 @@ struct ruler_limits {
 struct ruler {
   unsigned size;
   unsigned compact;
+  unsigned walkers;
 
   struct ring *volatile winner;
 
@@ -85,6 +98,8 @@ struct ruler {
   bool *subsume;
 
   struct clauses *occurrences;
+  unsigned **binaries; // shared irredundant binary clauses
+  struct flat_clauses *flat; // shared local search clauses
   pthread_t *threads;
   unsigned *unmap;    // internal => original
   unsigned *map;      // original => internal
@@ -94,6 +109,9 @@ struct ruler {
   struct ruler_barriers barriers;
   struct ruler_locks locks;
 
+  struct async async;
+  struct probing probing;
+  struct reclone reclone;
   struct clauses clauses;
   struct unsigneds extension[2];
 #ifndef NDEBUG
@@ -109,6 +127,10 @@ struct ruler {
   struct options options;
   struct ruler_profiles profiles;
   struct ruler_statistics statistics;
+  struct monitor monitor;
+#ifndef QUIET
+  struct sampler sampler;
+#endif
 
   // Clause export
   void *consume_clause_state;
@@ -170,6 +192,9 @@ void new_ruler_binary_clause (struct ruler *, unsigned, unsigned);
 void assign_ruler_unit (struct ruler *, unsigned unit);
 
 void connect_large_clause (struct ruler *, struct clause *);
+bool dereference_ruler_clause (struct ruler *, struct clause *);
+struct clause *unshare_ruler_clause (struct ruler *, struct clause *);
+void compress_ruler_clauses (struct ruler *);
 
 void disconnect_literal (struct ruler *, unsigned, struct clause *);
 
@@ -179,6 +204,7 @@ void set_winner (struct ring *);
 
 void set_terminate (struct ruler *, struct ring *);
 
+double flush_ruler_profiles (struct ruler *);
 void print_ruler_profiles (struct ruler *);
 
 /*------------------------------------------------------------------------*/
@@ -0,0 +1,135 @@
+// For 'clock_gettime' and 'pthread_sigmask' with '-std=c11'.
+
+#define _DEFAULT_SOURCE
+
+#ifndef QUIET
+
+#include "sample.h"
+#include "json.h"
+#include "message.h"
+#include "ruler.h"
+#include "system.h"
+
+#include <inttypes.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+
+#define ADD_SAMPLED_CLAUSES(SAMPLED, CLAUSES) \
+  do { \
+    (SAMPLED).units += (CLAUSES).units; \
+    (SAMPLED).clauses += (CLAUSES).clauses; \
+    (SAMPLED).binaries += (CLAUSES).binaries; \
+    (SAMPLED).tier1 += (CLAUSES).tier1; \
+    (SAMPLED).tier2 += (CLAUSES).tier2; \
+    (SAMPLED).tier3 += (CLAUSES).tier3; \
+  } while (0)
+
+static void take_sample (struct ruler *ruler, struct sample *sample) {
+  memset (sample, 0, sizeof *sample);
+  sample->time = current_time () - start_time;
+  for (all_rings (ring)) {
+    struct ring_statistics *s = &ring->statistics;
+    struct context *c = s->contexts + SEARCH_CONTEXT;
+    sample->conflicts += c->conflicts;
+    sample->decisions += c->decisions;
+    for (unsigned i = 0; i != SIZE_CONTEXTS; i++)
+      sample->propagations += s->contexts[i].propagations;
+    ADD_SAMPLED_CLAUSES (sample->imported, s->imported);
+    ADD_SAMPLED_CLAUSES (sample->exported, s->exported);
+    if (s->irredundant > sample->irredundant)
+      sample->irredundant = s->irredundant;
+    sample->redundant += s->redundant;
+  }
+}
+
+static bool sample_due (struct ruler *ruler, struct sample *sample) {
+  struct sample *last = &ruler->sampler.last;
+  unsigned seconds = ruler->options.sample_seconds;
+  if (seconds && sample->time >= last->time + seconds)
+    return true;
+  unsigned conflicts = ruler->options.sample_conflicts;
+  if (conflicts && sample->conflicts >= last->conflicts + conflicts)
+    return true;
+  return false;
+}
+
+static void *sample_statistics (void *ptr) {
+  struct ruler *ruler = ptr;
+  struct sampler *sampler = &ruler->sampler;
+  // Sampling after a number of conflicts requires polling.
+  double period = ruler->options.sample_conflicts
+                      ? 0.01
+                      : (double) ruler->options.sample_seconds;
+  if (pthread_mutex_lock (&sampler->lock))
+    fatal_error ("failed to acquire sampler lock");
+  while (!sampler->stop) {
+    struct timespec deadline;
+    clock_gettime (CLOCK_REALTIME, &deadline);
+    double wakeup = deadline.tv_sec + 1e-9 * deadline.tv_nsec + period;
+    deadline.tv_sec = wakeup;
+    deadline.tv_nsec = 1e9 * (wakeup - deadline.tv_sec);
+    (void) pthread_cond_timedwait (&sampler->wakeup, &sampler->lock,
+                                   &deadline);
+    if (sampler->stop)
+      break;
+    struct sample sample;
+    take_sample (ruler, &sample);
+    if (!sample_due (ruler, &sample))
+      continue;
+    sample.resident = current_resident_set_size ();
+    write_json_sample (&ruler->options.json, &sample, &sampler->last);
+    sampler->last = sample;
+    sampler->samples++;
+  }
+  if (pthread_mutex_unlock (&sampler->lock))
+    fatal_error ("failed to release sampler lock");
+  return 0;
+}
+
+void start_sampler (struct ruler *ruler) {
+  struct options *options = &ruler->options;
+  if (!options->json.file)
+    return;
+  if (!options->sample_seconds && !options->sample_conflicts)
+    return;
+  struct sampler *sampler = &ruler->sampler;
+  assert (!sampler->running);
+  pthread_mutex_init (&sampler->lock, 0);
+  pthread_cond_init (&sampler->wakeup, 0);
+  sampler->stop = false;
+  take_sample (ruler, &sampler->last);
+  // The signal handler writes the final JSON records.  If it would run in
+  // the sampler thread while that one is in the middle of writing a
+  // sample, the recursive file lock would not prevent interleaving.  Thus
+  // the sampler thread is started with all signals blocked.
+  sigset_t blocked, saved;
+  sigfillset (&blocked);
+  pthread_sigmask (SIG_BLOCK, &blocked, &saved);
+  if (pthread_create (&sampler->thread, 0, sample_statistics, ruler))
+    fatal_error ("failed to create sampler thread");
+  pthread_sigmask (SIG_SETMASK, &saved, 0);
+  sampler->running = true;
+  verbose (0, "sampling statistics every %u seconds and %u conflicts",
+           options->sample_seconds, options->sample_conflicts);
+}
+
+void stop_sampler (struct ruler *ruler) {
+  struct sampler *sampler = &ruler->sampler;
+  if (!sampler->running)
+    return;
+  if (pthread_mutex_lock (&sampler->lock))
+    fatal_error ("failed to acquire sampler lock");
+  sampler->stop = true;
+  pthread_cond_signal (&sampler->wakeup);
+  if (pthread_mutex_unlock (&sampler->lock))
+    fatal_error ("failed to release sampler lock");
+  if (pthread_join (sampler->thread, 0))
+    fatal_error ("failed to join sampler thread");
+  pthread_cond_destroy (&sampler->wakeup);
+  pthread_mutex_destroy (&sampler->lock);
+  sampler->running = false;
+  verbose (0, "sampler wrote %" PRIu64 " samples", sampler->samples);
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef _sample_h_INCLUDED
+#define _sample_h_INCLUDED
+
+#ifndef QUIET
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+struct ruler;
+
+// With '--stats-json=<file>' a sampler thread periodically sums up the
+// statistics of all rings (every 'sample_seconds' seconds or after
+// 'sample_conflicts' conflicts) and appends one sample to the file.  The
+// rings themselves are not involved.  Their counters are read without
+// synchronization and thus a sample might be slightly off.
+
+struct sampled_clauses {
+  uint64_t units;
+  uint64_t clauses;
+  uint64_t binaries;
+  uint64_t tier1;
+  uint64_t tier2;
+  uint64_t tier3;
+};
+
+struct sample {
+  double time;
+  uint64_t conflicts;
+  uint64_t decisions;
+  uint64_t propagations;
+  struct sampled_clauses imported, exported;
+  size_t irredundant;
+  size_t redundant;
+  size_t resident;
+};
+
+struct sampler {
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t wakeup;
+  bool running;
+  bool stop;
+  uint64_t samples;
+  struct sample last;
+};
+
+void start_sampler (struct ruler *);
+void stop_sampler (struct ruler *);
+
+#endif
+
+#endif
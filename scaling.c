@@ -0,0 +1,162 @@
+#ifndef QUIET
+
+#include "scaling.h"
+#include "allocate.h"
+#include "catch.h"
+#include "clone.h"
+#include "detach.h"
+#include "message.h"
+#include "parse.h"
+#include "ruler.h"
+#include "simplify.h"
+#include "solve.h"
+#include "system.h"
+#include "utilities.h"
+#include "witness.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+struct scaling {
+  unsigned threads;
+  int status;
+  double time;
+  double solve;
+  double simplify;
+  double clone;
+  double barrier;
+  double search;
+  uint64_t exported;
+  uint64_t imported;
+};
+
+static double barrier_waiting (struct ruler *ruler) {
+  double res = 0;
+  size_t size = SIZE (ruler->rings);
+  if (size < 2)
+    return 0;
+#define BARRIER(NAME) \
+  if (ruler->barriers.NAME.waits) \
+    for (size_t id = 0; id != size; id++) \
+      res += ruler->barriers.NAME.waits[id].time;
+  BARRIERS
+#undef BARRIER
+  return res / size;
+}
+
+static void collect_scaling (struct ruler *ruler, struct scaling *scaling) {
+  if (verbosity >= 0)
+    flush_ruler_profiles (ruler);
+  struct ruler_profiles *profiles = &ruler->profiles;
+  scaling->solve = profiles->solve.time;
+  scaling->simplify = profiles->simplify.time;
+  scaling->clone = profiles->clone.time;
+  scaling->barrier = barrier_waiting (ruler);
+  size_t size = SIZE (ruler->rings);
+  for (all_rings (ring)) {
+    if (verbosity >= 0)
+      flush_ring_profiles (ring);
+    scaling->search += ring->profiles.search.time / size;
+    struct ring_statistics *s = &ring->statistics;
+    scaling->exported += s->exported.clauses;
+    scaling->imported += s->imported.clauses;
+  }
+}
+
+static void run_scaling (struct options *options, unsigned threads,
+                         struct scaling *scaling) {
+  struct file *dimacs = &options->dimacs;
+  if (!dimacs->file) {
+    if (!(dimacs->file = fopen (dimacs->path, "r")))
+      fatal_error ("can not reopen '%s'", dimacs->path);
+    dimacs->lines = 0;
+  }
+  message (0, 0);
+  message (0, "scaling benchmark with %u threads", threads);
+  double start = current_time ();
+  options->threads = threads;
+  int variables, clauses;
+  parse_dimacs_header (options, &variables, &clauses);
+  struct ruler *ruler = new_ruler (variables, options);
+  set_signal_handlers (ruler);
+  parse_dimacs_body (ruler, variables, clauses);
+  dimacs->file = 0;
+  simplify_ruler (ruler);
+  clone_rings (ruler);
+  struct ring *winner = solve_rings (ruler);
+  int res = winner ? winner->status : 0;
+  reset_signal_handlers ();
+#ifndef NDEBUG
+  if (res == 10) {
+    signed char *witness = extend_witness (winner);
+    check_witness (witness, ruler->original);
+    free (witness);
+  }
+#endif
+  memset (scaling, 0, sizeof *scaling);
+  scaling->threads = threads;
+  scaling->status = res;
+  collect_scaling (ruler, scaling);
+  detach_and_delete_rings (ruler);
+  delete_ruler (ruler);
+  scaling->time = current_time () - start;
+  message (0, "scaling benchmark with %u threads took %.2f seconds",
+           threads, scaling->time);
+}
+
+static void print_scaling (struct scaling *scalings, unsigned size) {
+  if (verbosity < 0)
+    return;
+  printf ("c\n");
+  printf ("c %7s %6s %8s %7s %5s %8s %8s %8s %8s %8s %10s %10s\n",
+          "threads", "status", "time", "speedup", "eff", "solve",
+          "simplify", "clone", "barrier", "search", "exported",
+          "imported");
+  double base = scalings[0].time;
+  unsigned base_threads = scalings[0].threads;
+  for (unsigned i = 0; i != size; i++) {
+    struct scaling *s = scalings + i;
+    double speedup = s->time > 0 ? base / s->time : 0;
+    double efficiency = speedup * base_threads / s->threads;
+    printf ("c %7u %6d %8.2f %7.2f %4.0f%% %8.2f %8.2f %8.2f %8.2f "
+            "%8.2f %10" PRIu64 " %10" PRIu64 "\n",
+            s->threads, s->status, s->time, speedup, 100 * efficiency,
+            s->solve, s->simplify, s->clone, s->barrier, s->search,
+            s->exported, s->imported);
+  }
+  fflush (stdout);
+}
+
+int scaling_benchmark (struct options *options) {
+  unsigned size = options->scalings;
+  struct scaling *scalings = allocate_array (size, sizeof *scalings);
+  int res = 0;
+  for (unsigned i = 0; i != size; i++) {
+    struct scaling *scaling = scalings + i;
+    run_scaling (options, options->scaling[i], scaling);
+    int status = scaling->status;
+    if (!status)
+      continue;
+    if (res && res != status)
+      fatal_error ("scaling benchmark with %u threads returned %d "
+                   "but previous runs %d",
+                   scaling->threads, status, res);
+    res = status;
+  }
+  print_scaling (scalings, size);
+  free (scalings);
+  if (res == 20) {
+    if (verbosity >= 0)
+      printf ("c\n");
+    printf ("s UNSATISFIABLE\n");
+  } else if (res == 10) {
+    if (verbosity >= 0)
+      printf ("c\n");
+    printf ("s SATISFIABLE\n");
+  }
+  fflush (stdout);
+  return res;
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef _scaling_h_INCLUDED
+#define _scaling_h_INCLUDED
+
+#ifndef QUIET
+
+struct options;
+
+// With '--scaling=1,2,4,...' the same instance is parsed, simplified and
+// solved in-process once for each given number of threads.  Afterwards a
+// table with speed-up and parallel efficiency (relative to the first
+// thread count) is printed, together with the time spent in the ruler
+// profiles 'solve', 'simplify' and 'clone', the average time per ring
+// waiting at barriers and searching, and the number of shared clauses.
+
+int scaling_benchmark (struct options *);
+
+#endif
+
+#endif
@@ -1,5 +1,6 @@
 #include "search.h"
 #include "analyze.h"
+#include "async.h"
 #include "backtrack.h"
 #include "decide.h"
 #include "export.h"
@@ -148,6 +149,9 @@ int search (struct ring *ring) {
       //if (ring->id == 0) {
       //  gimsatul_import_redundant_clauses(ring);
       //}
+      adopt_asynchronous_simplification (ring);
+      if (ring->inconsistent)
+        res = 20;
     }
     else if (switching_mode (ring))
       switch_mode (ring);
@@ -155,8 +159,12 @@ int search (struct ring *ring) {
       rephase (ring);
     else if (probing (ring))
       res = probe (ring);
+    else if (simplifying_asynchronously (ring))
+      res = start_asynchronous_simplification (ring);
     else if (simplifying (ring))
       res = simplify_ring (ring);
+    else if (ring->walker)
+      dedicated_local_search (ring);
     else if (!import_shared (ring))
       decide (ring);
     else if (ring->inconsistent)
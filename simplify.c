@@ -1,4 +1,5 @@
 #include "simplify.h"
+#include "async.h"
 #include "backtrack.h"
 #include "clone.h"
 #include "compact.h"
@@ -14,8 +15,8 @@
 #include "substitute.h"
 #include "subsume.h"
 #include "trace.h"
-#include "unclone.h"
 #include "utilities.h"
+#include "walk.h"
 
 #include <inttypes.h>
 #include <string.h>
@@ -268,17 +269,23 @@ delete_large_garbage_ruler_clauses (struct simplifier *simplifier) {
     struct clause *clause = *q++ = *p++;
     if (clause->garbage) {
       ROGCLAUSE (clause, "finally deleting");
-      free (clause);
+      (void) dereference_ruler_clause (ruler, clause);
 #ifndef QUIET
       deleted++;
 #endif
       q--;
     } else if (clause->dirty) {
       assert (EMPTY (remove));
+      struct clause *copy = unshare_ruler_clause (ruler, clause);
+      if (copy != clause) {
+        (void) dereference_ruler_clause (ruler, clause);
+        q[-1] = clause = copy;
+      }
 #ifndef QUIET
       shrunken++;
 #endif
       ROGCLAUSE (clause, "shrinking dirty");
+      assert (!clause->compressed);
       unsigned *literals = clause->literals;
       unsigned old_size = clause->size;
       assert (old_size > 2);
@@ -316,7 +323,7 @@ delete_large_garbage_ruler_clauses (struct simplifier *simplifier) {
         new_ruler_binary_clause (ruler, lit, other);
         mark_subsume_literal (simplifier, other);
         mark_subsume_literal (simplifier, lit);
-        free (clause);
+        (void) dereference_ruler_clause (ruler, clause);
         q--;
       }
     }
@@ -647,18 +654,11 @@ static void run_full_blown_simplification (struct simplifier *simplifier) {
     try_to_increase_elimination_bound (ruler);
 }
 
-void simplify_ruler (struct ruler *ruler) {
-  if (ruler->inconsistent)
-    return;
-
-#ifndef QUIET
-  double start_simplification = START (ruler, simplify);
-#endif
+static bool run_ruler_simplification (struct simplifier *simplifier) {
+  struct ruler *ruler = simplifier->ruler;
   assert (!ruler->simplifying);
   ruler->simplifying = true;
 
-  struct simplifier *simplifier = new_simplifier (ruler);
-
   bool initially = !ruler->statistics.simplifications++;
   bool full_simplification = ruler->options.simplify;
 
@@ -676,24 +676,60 @@ void simplify_ruler (struct ruler *ruler) {
   else
     run_only_root_level_propagation (simplifier);
 
-  push_ruler_units_to_extension_stack (ruler);
-  compact_ruler (simplifier, initially);
-  delete_simplifier (simplifier);
-
   assert (ruler->simplifying);
   ruler->simplifying = false;
 
+  return initially;
+}
+
+static void compact_simplified_ruler (struct simplifier *simplifier,
+                                      bool initially) {
+  push_ruler_units_to_extension_stack (simplifier->ruler);
+  compact_ruler (simplifier, initially);
+}
+
 #ifndef QUIET
-  double end_simplification = STOP (ruler, simplify);
-  if (full_simplification)
-    message (0, 0);
+
+static void report_simplification_time (struct ruler *ruler,
+                                        double start) {
+  double end = STOP (ruler, simplify);
+  message (0, 0);
   message (0, "simplification #%" PRIu64 " took %.2f seconds",
-           ruler->statistics.simplifications,
-           end_simplification - start_simplification);
+           ruler->statistics.simplifications, end - start);
   reset_report ();
+}
+
+#endif
+
+void simplify_ruler (struct ruler *ruler) {
+  if (ruler->inconsistent)
+    return;
+#ifndef QUIET
+  double start = START (ruler, simplify);
+#endif
+  struct simplifier *simplifier = new_simplifier (ruler);
+  bool initially = run_ruler_simplification (simplifier);
+  compact_simplified_ruler (simplifier, initially);
+  delete_simplifier (simplifier);
+#ifndef QUIET
+  report_simplification_time (ruler, start);
 #endif
 }
 
+// Simplifies the snapshot handed to the asynchronous simplifier thread.
+// There is no compaction, since the rings keep their variable indices.
+
+void simplify_snapshot (struct ruler *ruler) {
+  assert (!ruler->simplifying);
+  ruler->simplifying = true;
+  struct simplifier *simplifier = new_simplifier (ruler);
+  ruler->statistics.simplifications++;
+  run_full_blown_simplification (simplifier);
+  delete_simplifier (simplifier);
+  assert (ruler->simplifying);
+  ruler->simplifying = false;
+}
+
 static void trigger_synchronization (struct ring *ring) {
   if (!ring->id) {
     struct ruler *ruler = ring->ruler;
@@ -765,42 +801,87 @@ static bool synchronize_exported_and_imported_units (struct ring *ring) {
   return !ring->inconsistent;
 }
 
-static bool unclone_before_running_simplification (struct ring *ring) {
-  if (!rendezvous (&ring->ruler->barriers.unclone, ring, false))
+static bool share_before_running_simplification (struct ring *ring) {
+  if (!rendezvous (&ring->ruler->barriers.share, ring, false))
     return false;
-  unclone_ring (ring);
+  if (!ring->id)
+    share_ring_clauses_with_ruler (ring);
   return true;
 }
 
-static void clone_first_ring_after_simplification (struct ring *ring) {
-  assert (!ring->id);
-  assert (ring->ruler->inconsistent || ring->references ||
-          ring->ruler->terminate);
-  copy_ruler (ring);
-}
-
-static void run_ring_simplification (struct ring *ring) {
+static struct simplifier *run_ring_simplification (struct ring *ring) {
   struct ruler *ruler = ring->ruler;
   (void) rendezvous (&ruler->barriers.run, ring, true);
   if (ring->id)
-    return;
+    return 0;
   STOP (ruler, solve);
-  simplify_ruler (ruler);
+  stop_asynchronous_simplification (ruler);
+  release_flat_clauses (ruler);
+  struct simplifier *simplifier = 0;
+  if (!ruler->inconsistent) {
+#ifndef QUIET
+    double start = START (ruler, simplify);
+#endif
+    simplifier = new_simplifier (ruler);
+    apply_asynchronous_simplification (simplifier);
+    (void) run_ruler_simplification (simplifier);
+#ifndef QUIET
+    report_simplification_time (ruler, start);
+#endif
+  }
   START (ruler, solve);
-  clone_first_ring_after_simplification (ring);
+  prepare_recloning (ring);
+  return simplifier;
 }
 
-static void copy_other_ring_after_simplification (struct ring *ring) {
+static void reclone_ring_after_simplification (struct ring *ring) {
   struct ruler *ruler = ring->ruler;
-  (void) rendezvous (&ruler->barriers.copy, ring, true);
-  if (!ring->id)
+  (void) rendezvous (&ruler->barriers.reclone, ring, true);
+  reclone_ring (ring);
+}
+
+static void compact_first_ring_after_simplification (
+    struct ring *ring, struct simplifier *simplifier) {
+  struct ruler *ruler = ring->ruler;
+  struct reclone *reclone = &ruler->reclone;
+  if (reclone->incremental) {
+    if (simplifier)
+      delete_simplifier (simplifier);
     return;
-  if (ruler->inconsistent)
+  }
+  (void) rendezvous (&ruler->barriers.compact, ring, true);
+  if (ring->id)
     return;
-  if (ruler->terminate)
+  if (simplifier) {
+    compact_simplified_ruler (simplifier, false);
+    delete_simplifier (simplifier);
+  }
+  reclone->copying = !ruler->inconsistent && !ruler->terminate;
+  if (reclone->copying)
+    compress_ruler_clauses (ruler);
+}
+
+static void copy_slices_after_simplification (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct reclone *reclone = &ruler->reclone;
+  if (reclone->incremental)
+    return;
+  (void) rendezvous (&ruler->barriers.copy, ring, true);
+  if (reclone->copying)
+    copy_ruler_slice (ring);
+}
+
+static void attach_ring_after_simplification (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  struct reclone *reclone = &ruler->reclone;
+  if (reclone->incremental)
     return;
-  assert (ring->references);
-  copy_ring (ring);
+  (void) rendezvous (&ruler->barriers.attach, ring, true);
+  if (reclone->copying) {
+    assert (ring->references);
+    attach_ring (ring);
+  } else if (!ring->id)
+    copy_ruler (ring);
 }
 
 static void finish_ring_simplification (struct ring *ring) {
@@ -808,13 +889,14 @@ static void finish_ring_simplification (struct ring *ring) {
   (void) rendezvous (&ruler->barriers.end, ring, true);
   if (ring->id)
     return;
-  RELEASE (ruler->clauses);
+  finish_recloning (ring);
   struct ring_limits *limits = &ring->limits;
   struct ring_statistics *statistics = &ring->statistics;
   uint64_t base = ring->options.simplify_interval;
   uint64_t interval = base * nlog2n (statistics->simplifications);
   uint64_t scaled = scale_interval (ring, "simplify", interval);
   limits->simplify = SEARCH_CONFLICTS + scaled;
+  limits->async = SEARCH_CONFLICTS + scaled / 2;
   ruler->last.search = statistics->contexts[SEARCH_CONTEXT].ticks;
   very_verbose (
       ring, "new simplify limit at %" PRIu64 " after %" PRIu64 " conflicts",
@@ -835,12 +917,16 @@ int simplify_ring (struct ring *ring) {
   if (!synchronize_exported_and_imported_units (ring))
     return ring->status;
   ring->trail.propagate = ring->trail.begin;
-  if (!unclone_before_running_simplification (ring))
+  release_walking (ring);
+  if (!share_before_running_simplification (ring))
     return ring->status;
   ring->statistics.simplifications++;
   STOP_SEARCH ();
-  run_ring_simplification (ring);
-  copy_other_ring_after_simplification (ring);
+  struct simplifier *simplifier = run_ring_simplification (ring);
+  reclone_ring_after_simplification (ring);
+  compact_first_ring_after_simplification (ring, simplifier);
+  copy_slices_after_simplification (ring);
+  attach_ring_after_simplification (ring);
   finish_ring_simplification (ring);
 #ifndef NDEBUG
   if (!ring->ruler->inconsistent && !ring->ruler->terminate) {
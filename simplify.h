@@ -24,6 +24,7 @@ void recycle_clause (struct simplifier *, struct clause *, unsigned except);
 void recycle_clauses (struct simplifier *, struct clauses *,
                       unsigned except);
 void simplify_ruler (struct ruler *);
+void simplify_snapshot (struct ruler *);
 
 /*------------------------------------------------------------------------*/
 
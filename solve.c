@@ -11,7 +11,13 @@
 
 static void *solve_routine (void *ptr) {
   struct ring *ring = ptr;
+#ifndef QUIET
+  start_ring_perf_counters (ring);
+#endif
   int res = search (ring);
+#ifndef QUIET
+  stop_ring_perf_counters (ring);
+#endif
   assert (ring->status == res);
   (void) res;
   return ring;
@@ -136,6 +142,7 @@ static void set_ring_limits (struct ring *ring, long long conflicts) {
     uint64_t scaled = scale_interval (ring, "simplify", interval);
     verbose (ring, "simplify limit of %" PRIu64 " conflicts", scaled);
     limits->simplify = scaled;
+    limits->async = scaled / 2;
   }
 
   if (conflicts >= 0) {
@@ -144,6 +151,27 @@ static void set_ring_limits (struct ring *ring, long long conflicts) {
   }
 }
 
+// The last rings are turned into dedicated walker rings (see 'walk.c'),
+// but at least the first ring keeps searching.
+
+static void assign_walker_rings (struct ruler *ruler) {
+  unsigned threads = SIZE (ruler->rings);
+  unsigned walkers = ruler->options.walkers;
+  if (walkers >= threads) {
+    walkers = threads - 1;
+    message (0, "can only use %u walker threads with %u threads",
+             walkers, threads);
+  }
+  ruler->walkers = walkers;
+  for (all_rings (ring)) {
+    if (ring->id < threads - walkers)
+      continue;
+    ring->walker = true;
+    ring->options.target_phases = 0;
+    verbose (ring, "dedicated walker ring");
+  }
+}
+
 struct ring *solve_rings (struct ruler *ruler) {
   if (ruler->terminate)
     return ruler->winner;
@@ -163,11 +191,13 @@ struct ring *solve_rings (struct ruler *ruler) {
   for (all_rings (ring)) {
     set_ring_limits (ring, conflicts);
   }
+  assign_walker_rings (ruler);
+  start_monitor (ruler);
+#ifndef QUIET
+  start_sampler (ruler);
+#endif
   message (0, 0);
   if (threads > 1) {
-    for (all_rings (ring))
-      ring->probe = ring->id * (ruler->compact / threads);
-
     message (0, "starting and running %zu ring threads", threads);
 
 #define BARRIER(NAME) init_barrier (&ruler->barriers.NAME, #NAME, threads);
@@ -187,6 +217,11 @@ struct ring *solve_rings (struct ruler *ruler) {
     struct ring *ring = first_ring (ruler);
     (void) solve_routine (ring);
   }
+  stop_asynchronous_simplification (ruler);
+#ifndef QUIET
+  stop_sampler (ruler);
+#endif
+  stop_monitor (ruler);
   assert (ruler->solving);
   ruler->solving = false;
 #ifndef QUIET
@@ -2,16 +2,48 @@
 
 #include "statistics.h"
 #include "message.h"
+#include "perf.h"
 #include "ruler.h"
+#include "system.h"
 #include "tiers.h"
 #include "utilities.h"
 
 #include <inttypes.h>
 
+static void print_sharing_statistics (struct ring *ring) {
+  static const char *names[SIZE_SHARING_TIERS] = {"binary", "tier1",
+                                                  "tier2", "tier3"};
+  struct ring_statistics *s = &ring->statistics;
+  char name[32];
+  for (unsigned i = 0; i != SIZE_SHARING_TIERS; i++) {
+    struct sharing *sharing = s->sharing.tiers + i;
+    if (!sharing->imported)
+      continue;
+    sprintf (name, "  shared-%s:", names[i]);
+    PRINTLN ("%-22s %17" PRIu64 " %13.2f ms delay", name,
+             sharing->imported, 1e3 * average (sharing->delay,
+                                               sharing->imported));
+    if (!i)
+      continue;
+    sprintf (name, "    useful-%s:", names[i]);
+    PRINTLN ("%-22s %17" PRIu64 " %13.2f %% retired", name,
+             sharing->useful, percent (sharing->useful, sharing->retired));
+  }
+  for (unsigned i = 0; i != ring->threads; i++) {
+    struct sharing *sharing = s->sharing.sources + i;
+    if (!sharing->imported)
+      continue;
+    sprintf (name, "  shared-from-%u:", i);
+    PRINTLN ("%-22s %17" PRIu64 " %13.2f %% useful", name,
+             sharing->imported, percent (sharing->useful, sharing->retired));
+  }
+}
+
 void print_ring_statistics (struct ring *ring) {
   print_ring_profiles (ring);
   double search = ring->profiles.search.time;
   double walk = ring->profiles.solve.time;
+  double fail = ring->profiles.fail.time;
   struct ring_statistics *s = &ring->statistics;
   struct context *c = s->contexts + SEARCH_CONTEXT;
   uint64_t conflicts = c->conflicts;
@@ -59,6 +91,11 @@ void print_ring_statistics (struct ring *ring) {
            percent (s->failed, variables));
   PRINTLN ("%-22s %17u %13.2f %% variables", "lifted-literals:", s->lifted,
            percent (s->lifted, variables));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f per second", "probed-literals:",
+           s->probes.probed, average (s->probes.probed, fail));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f %% probed",
+           "  unique-probes:", s->probes.unique,
+           percent (s->probes.unique, s->probes.probed));
   PRINTLN ("%-22s %17u %13.2f %% variables", "fixed-variables:", s->fixed,
            percent (s->fixed, variables));
   PRINTLN ("%-22s %17" PRIu64 " %13.2f %% fixed",
@@ -82,6 +119,15 @@ void print_ring_statistics (struct ring *ring) {
   PRINTLN ("%-22s %17" PRIu64 " %13.2f %% per learned clause",
            "  vivify-tried:", s->vivify.tried,
            percent (s->vivify.tried, s->learned.clauses));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f %% per vivify-tried",
+           "  vivify-irredundant:", s->vivify.irredundant,
+           percent (s->vivify.irredundant, s->vivify.tried));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f %% per vivify-tried",
+           "  vivify-duplicated:", s->vivify.duplicated,
+           percent (s->vivify.duplicated, s->vivify.tried));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f %% per vivify-irredundant",
+           "  vivify-retried:", s->vivify.retried,
+           percent (s->vivify.retried, s->vivify.irredundant));
   PRINTLN ("%-22s %17" PRIu64 " %13.2f %% per vivify-tried",
            "  vivify-reused:", s->vivify.reused,
            percent (s->vivify.reused, s->vivify.tried));
@@ -184,6 +230,15 @@ void print_ring_statistics (struct ring *ring) {
   PRINTLN ("%-22s %17" PRIu64 " %13.2f millions per second",
            "propagations:", propagations,
            average (propagations, 1e6 * search));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f millions per second", "ticks:",
+           c->ticks, average (c->ticks, 1e6 * search));
+  if (s->decompressed) {
+    uint64_t ticks = 0;
+    for (unsigned i = 0; i != SIZE_CONTEXTS; i++)
+      ticks += s->contexts[i].ticks;
+    PRINTLN ("%-22s %17" PRIu64 " %13.2f %% ticks", "  decompressed:",
+             s->decompressed, percent (s->decompressed, ticks));
+  }
 #ifdef METRICS
   PRINTLN ("%-22s %17" PRIu64 " %13.2f per propagation", "visits:", visits,
            average (visits, propagations));
@@ -215,6 +270,33 @@ void print_ring_statistics (struct ring *ring) {
   PRINTLN ("%-22s %17" PRIu64 " %13.2f %% reduced",
            "  reduced-tier3:", s->reduced.tier3,
            percent (s->reduced.tier3, s->reduced.clauses));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f per reduction",
+           "  reduce-watchers:", s->reduced.watchers,
+           average (s->reduced.watchers, s->reductions));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f %% watchers",
+           "  reduce-visited:", s->reduced.visited,
+           percent (s->reduced.visited, s->reduced.watchers));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f %% reductions",
+           "  reduce-flushed:", s->reduced.flushed,
+           percent (s->reduced.flushed, s->reductions));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f per reduction",
+           "  reduce-dropped:", s->reduced.dropped,
+           average (s->reduced.dropped, s->reductions));
+  for (unsigned i = 0; i != SIZE_REDUCE_STATISTICS; i++) {
+    uint64_t count = s->reduce_by_size[i].count;
+    if (!count)
+      continue;
+    char name[24];
+    sprintf (name, "  reduce-size-2^%u:", i);
+    PRINTLN ("%-22s %17" PRIu64 " %13.2f ms per reduction", name, count,
+             1e3 * average (s->reduce_by_size[i].time, count));
+  }
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f per reduction",
+           "  forwarded-lazily:", s->forwarded.lazily,
+           average (s->forwarded.lazily, s->reductions));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f per reduction",
+           "  forwarded-eagerly:", s->forwarded.eagerly,
+           average (s->forwarded.eagerly, s->reductions));
 
   if (ring->pool) {
     PRINTLN ("%-22s %17" PRIu64 " %13.2f %% learned clauses",
@@ -224,6 +306,7 @@ void print_ring_statistics (struct ring *ring) {
              "  diverged-imports:", s->diverged,
              percent (s->diverged, s->imported.clauses));
     PRINT_CLAUSE_STATISTICS (imported);
+    print_sharing_statistics (ring);
 
     {
       uint64_t subsumed =
@@ -259,6 +342,26 @@ void print_ring_statistics (struct ring *ring) {
            "switched:", s->switched, average (conflicts, s->switched));
   PRINTLN ("%-22s %17" PRIu64 " %13.2f flips per walked",
            "walked:", s->walked, average (s->flips, s->walked));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f %% walked",
+           "  walk-connected:", s->walks.connected,
+           percent (s->walks.connected, s->walked));
+  PRINTLN ("%-22s %17" PRIu64 " %13.2f %% walked",
+           "  walk-reused:", s->walks.reused,
+           percent (s->walks.reused, s->walked));
+  if (s->walks.kept)
+    PRINTLN ("%-22s %17" PRIu64 " %13.2f MB kept",
+             "  walk-kept:", s->walks.kept,
+             s->walks.kept / (double) (1 << 20));
+  if (ring->ruler->walkers) {
+    uint64_t rounds = ring->walker ? s->walked : s->rephased;
+    const char *type = ring->walker ? "walked" : "rephased";
+    PRINTLN ("%-22s %17" PRIu64 " %13.2f per %s",
+             "  published-phases:", s->phases.published,
+             average (s->phases.published, rounds), type);
+    PRINTLN ("%-22s %17" PRIu64 " %13.2f %% %s",
+             "  adopted-phases:", s->phases.adopted,
+             percent (s->phases.adopted, rounds), type);
+  }
   fflush (stdout);
 }
 
@@ -300,10 +403,74 @@ void print_ruler_statistics (struct ruler *ruler) {
           percent (s->strengthened, s->original));
   printf ("c %-22s %17" PRIu64 "\n",
           "simplifications:", s->simplifications);
+  if (s->async.simplifications) {
+    printf ("c %-22s %17" PRIu64 " %13.2f %% simplifications\n",
+            "  async-simplified:", s->async.simplifications,
+            percent (s->async.simplifications,
+                     s->simplifications + s->async.simplifications));
+    printf ("c %-22s %17" PRIu64 " %13.2f per simplification\n",
+            "  async-units:", s->async.units,
+            average (s->async.units, s->async.simplifications));
+    printf ("c %-22s %17" PRIu64 " %13.2f per simplification\n",
+            "  async-equivalences:", s->async.equivalences,
+            average (s->async.equivalences, s->async.simplifications));
+    printf ("c %-22s %17" PRIu64 " %13.2f per simplification\n",
+            "  async-binaries:", s->async.binaries,
+            average (s->async.binaries, s->async.simplifications));
+    printf ("c %-22s %17" PRIu64 " %13.2f per simplification\n",
+            "  async-clauses:", s->async.clauses,
+            average (s->async.clauses, s->async.simplifications));
+  }
+  if (s->reclone.full || s->reclone.incremental) {
+    struct reclone *reclone = &ruler->reclone;
+    printf ("c %-22s %17" PRIu64 " %13.2f ms per re-cloning\n",
+            "  reclone-full:", s->reclone.full,
+            1e3 * average (reclone->time.full, s->reclone.full));
+    printf ("c %-22s %17" PRIu64 " %13.2f ms per re-cloning\n",
+            "  reclone-incremental:", s->reclone.incremental,
+            1e3 * average (reclone->time.incremental,
+                           s->reclone.incremental));
+    printf ("c %-22s %17" PRIu64 " %13.2f per re-cloning\n",
+            "  reclone-unshared:", s->reclone.unshared,
+            average (s->reclone.unshared,
+                     s->reclone.full + s->reclone.incremental));
+  }
+  if (ruler->walkers) {
+    uint64_t flips = 0;
+    double time = 0;
+    for (all_rings (ring))
+      if (ring->walker) {
+        flips += ring->statistics.flips;
+        time += ring->profiles.walk.time;
+      }
+    printf ("c %-22s %17" PRIu64 " %13.2f thousands per second\n",
+            "walker-flips:", flips, average (flips, 1e3 * time));
+  }
+  {
+    uint64_t rounds = 0, unique = 0;
+    for (all_rings (ring)) {
+      rounds += ring->statistics.probes.rounds;
+      unique += ring->statistics.probes.unique;
+    }
+    printf ("c %-22s %17" PRIu64 " %13.2f unique probes per round\n",
+            "probing-rounds:", rounds, average (unique, rounds));
+  }
   printf ("c %-22s %17" PRIu64 " %13.2f %% original clauses\n",
           "subsumed:", s->subsumed, percent (s->subsumed, s->original));
   printf ("c %-22s %17zu %13.2f %% original clauses\n",
           "weakened:", s->weakened, percent (s->weakened, s->original));
+  if (s->compressed.clauses) {
+    printf ("c %-22s %17" PRIu64 " %13.2f literals per clause\n",
+            "compressed:", s->compressed.clauses,
+            average (s->compressed.literals, s->compressed.clauses));
+    printf ("c %-22s %17" PRIu64 " %13.2f bytes per literal\n",
+            "  compressed-bytes:", s->compressed.bytes,
+            average (s->compressed.bytes, s->compressed.literals));
+    printf ("c %-22s %17" PRIu64 " %13.2f %% uncompressed bytes\n",
+            "  compressed-saved:", s->compressed.saved,
+            percent (s->compressed.saved,
+                     s->compressed.bytes + s->compressed.saved));
+  }
   printf ("c %-22s %17u %13.2f %% total-fixed\n",
           "simplifying-fixed:", s->fixed.simplifying,
           percent (s->fixed.simplifying, s->fixed.total));
@@ -321,6 +488,26 @@ void print_ruler_statistics (struct ruler *ruler) {
   printf ("c %-30s %23.2f seconds\n", "process-time:", process);
   printf ("c %-30s %23.2f seconds\n", "wall-clock-time:", total);
   printf ("c %-30s %23.2f MB\n", "maximum-resident-set-size:", memory);
+  if (huge_pages.arrays || huge_pages.advised) {
+    printf ("c %-30s %23zu arrays\n", "huge-page-arrays:",
+            (size_t) huge_pages.arrays);
+    printf ("c %-30s %23.2f MB\n", "huge-page-advised:",
+            huge_pages.advised / (double) (1 << 20));
+    printf ("c %-30s %23.2f MB\n", "transparent-huge-pages:",
+            transparent_huge_pages_size () / (double) (1 << 20));
+    if (huge_pages.failed)
+      printf ("c %-30s %23zu calls\n", "huge-page-advice-failed:",
+              (size_t) huge_pages.failed);
+  }
+  uint64_t misses;
+  if (tlb_misses (ruler, &misses)) {
+    uint64_t propagations = 0;
+    for (all_rings (ring))
+      for (unsigned i = 0; i != SIZE_CONTEXTS; i++)
+        propagations += ring->statistics.contexts[i].propagations;
+    printf ("c %-30s %23.2f per propagation\n", "dtlb-load-misses:",
+            average (misses, propagations));
+  }
 
   fflush (stdout);
 }
@@ -22,6 +22,25 @@ struct usage {
   uint64_t glue[MAX_GLUE];
 };
 
+// Provenance of clauses imported from other rings, aggregated by the tier
+// of their glue at export (binary clauses first) and by source ring.  The
+// 'delay' sums up the seconds from export (right after learning) to the
+// import.  Imported large clauses are retired as soon as they become
+// garbage or are saved during simplification.  Then they count as
+// 'propagated' if they were a reason during propagation and as 'analyzed'
+// if they were bumped during conflict analysis since being imported.
+
+#define SIZE_SHARING_TIERS 4
+
+struct sharing {
+  uint64_t imported;
+  uint64_t retired;
+  uint64_t propagated;
+  uint64_t analyzed;
+  uint64_t useful;
+  double delay;
+};
+
 struct context {
   uint64_t ticks;
   uint64_t jumped;
@@ -44,6 +63,17 @@ struct ring_statistics {
   uint64_t switched;
   uint64_t walked;
 
+  struct {
+    uint64_t published;
+    uint64_t adopted;
+  } phases;
+
+  struct {
+    uint64_t connected;
+    uint64_t reused;
+    uint64_t kept;
+  } walks;
+
 #define SEARCH_CONTEXT 0
 #define PROBING_CONTEXT 1
 #define WALK_CONTEXT 2
@@ -65,6 +95,12 @@ struct ring_statistics {
   unsigned fixed;
   unsigned lifted;
 
+  struct {
+    uint64_t probed;
+    uint64_t unique;
+    uint64_t rounds;
+  } probes;
+
   size_t irredundant;
   size_t redundant;
 
@@ -76,6 +112,9 @@ struct ring_statistics {
     uint64_t subsumed;
     uint64_t succeeded;
     uint64_t implied;
+    uint64_t irredundant;
+    uint64_t duplicated;
+    uint64_t retried;
   } vivify;
 
   struct {
@@ -89,6 +128,8 @@ struct ring_statistics {
   uint64_t bumped;
   struct usage usage[2];
 
+  uint64_t decompressed;
+
   struct {
     uint64_t clauses;
     uint64_t tier1;
@@ -116,13 +157,36 @@ struct ring_statistics {
 #endif
   } learned, exported, imported;
 
+  struct {
+    struct sharing tiers[SIZE_SHARING_TIERS];
+    struct sharing *sources;
+  } sharing;
+
   struct {
     uint64_t clauses;
     uint64_t tier1;
     uint64_t tier2;
     uint64_t tier3;
+    uint64_t visited;
+    uint64_t watchers;
+    uint64_t flushed;
+    uint64_t dropped;
   } reduced;
 
+#define SIZE_REDUCE_STATISTICS 32
+
+#ifndef QUIET
+  struct {
+    uint64_t count;
+    double time;
+  } reduce_by_size[SIZE_REDUCE_STATISTICS];
+#endif
+
+  struct {
+    uint64_t lazily;
+    uint64_t eagerly;
+  } forwarded;
+
   struct {
     struct {
       uint64_t checked;
@@ -226,6 +290,24 @@ struct ruler_statistics {
     uint64_t elimination;
     uint64_t subsumption;
   } ticks;
+  struct {
+    uint64_t simplifications;
+    uint64_t units;
+    uint64_t equivalences;
+    uint64_t binaries;
+    uint64_t clauses;
+  } async;
+  struct {
+    uint64_t full;
+    uint64_t incremental;
+    uint64_t unshared;
+  } reclone;
+  struct {
+    uint64_t clauses;
+    uint64_t literals;
+    uint64_t bytes;
+    uint64_t saved;
+  } compressed;
   struct {
     unsigned simplifying;
     unsigned solving;
@@ -5,22 +5,330 @@
 #include "trace.h"
 #include "utilities.h"
 
-static unsigned *find_equivalent_literals (struct simplifier *simplifier,
+#include <pthread.h>
+#include <stdatomic.h>
+
+// Equivalent literals are the strongly connected components of the binary
+// implication graph given by the binary clauses in the occurrence lists.
+// With enough binary clauses (see 'substitute_parallel') the components
+// are first determined in parallel by the coloring algorithm.  Each round
+// removes literals without unresolved predecessors or successors (these
+// form singleton components), propagates the maximum literal along the
+// implication edges until a fix-point is reached and then collects for
+// each literal which kept its own color (the root) all literals of the
+// same color which reach the root.  These form the component of the root.
+// Since components of different roots have different colors, the backward
+// searches of different roots are independent.  As long chains require
+// many propagation sweeps, after a few rounds the remaining literals are
+// handed over to the serial Tarjan algorithm, which only needs to consider
+// literals not yet resolved.  Then every clause with a substituted literal
+// is rewritten by replacing all its literals with their representatives,
+// again in parallel for disjoint literal ranges, while the resulting
+// resolvents are added and the original clauses deleted serially.
+
+#define MAX_COLORING_ROUNDS 16
+#define MAX_COLORING_SWEEPS 64
+
+#define VISITED (INVALID - 1)
+
+struct substitution;
+
+struct substitution_worker {
+  struct substitution *substitution;
+  pthread_t thread;
+  unsigned id, begin, end;
+  unsigned active, equivalences, complementary;
+  bool changed;
+  signed char *marks;
+  struct unsigneds stack, component;
+  struct unsigneds resolvents;
+  struct clauses substituted, deleted;
+};
+
+struct substitution {
+  struct simplifier *simplifier;
+  unsigned threads;
+  unsigned *repr;
+  _Atomic (unsigned) *colors;
+  struct substitution_worker *workers;
+#ifndef QUIET
+  unsigned rounds, remaining;
+#endif
+};
+
+static void init_substitution (struct substitution *substitution,
+                               struct simplifier *simplifier) {
+  struct ruler *ruler = simplifier->ruler;
+  unsigned threads = 1;
+  unsigned limit = ruler->options.substitute_parallel;
+  if (limit && ruler->statistics.binaries >= limit)
+    threads = ruler->options.threads;
+  substitution->simplifier = simplifier;
+  substitution->threads = threads;
+  substitution->repr = 0;
+  substitution->colors = 0;
+  substitution->workers =
+      allocate_and_clear_array (threads, sizeof *substitution->workers);
+#ifndef QUIET
+  substitution->rounds = substitution->remaining = 0;
+#endif
+  unsigned literals = 2 * ruler->compact;
+  for (unsigned id = 0; id != threads; id++) {
+    struct substitution_worker *worker = substitution->workers + id;
+    worker->substitution = substitution;
+    worker->id = id;
+    worker->begin = (uint64_t) literals * id / threads;
+    worker->end = (uint64_t) literals * (id + 1) / threads;
+  }
+}
+
+static void release_substitution (struct substitution *substitution) {
+  struct simplifier *simplifier = substitution->simplifier;
+  for (unsigned id = 0; id != substitution->threads; id++) {
+    struct substitution_worker *worker = substitution->workers + id;
+    if (worker->marks != simplifier->marks)
+      free (worker->marks);
+    RELEASE (worker->stack);
+    RELEASE (worker->component);
+    RELEASE (worker->resolvents);
+    RELEASE (worker->substituted);
+    RELEASE (worker->deleted);
+  }
+  free (substitution->workers);
+  free (substitution->colors);
+}
+
+static void run_substitution_workers (struct substitution *substitution,
+                                      void *(*routine) (void *)) {
+  struct substitution_worker *workers = substitution->workers;
+  unsigned threads = substitution->threads;
+  for (unsigned id = 1; id < threads; id++)
+    if (pthread_create (&workers[id].thread, 0, routine, workers + id))
+      fatal_error ("failed to create substitution thread %u", id);
+  routine (workers);
+  for (unsigned id = 1; id < threads; id++)
+    if (pthread_join (workers[id].thread, 0))
+      fatal_error ("failed to join substitution thread %u", id);
+}
+
+/*------------------------------------------------------------------------*/
+
+static void complementary_equivalence (struct ruler *ruler, unsigned lit) {
+  very_verbose (0, "%s", "empty resolvent");
+  trace_add_unit (&ruler->trace, lit);
+  assign_ruler_unit (ruler, lit);
+  trace_add_empty (&ruler->trace);
+  ruler->inconsistent = true;
+}
+
+static inline unsigned load_color (struct substitution *substitution,
+                                   unsigned lit) {
+  return atomic_load_explicit (substitution->colors + lit,
+                               memory_order_relaxed);
+}
+
+static inline void store_color (struct substitution *substitution,
+                                unsigned lit, unsigned color) {
+  atomic_store_explicit (substitution->colors + lit, color,
+                         memory_order_relaxed);
+}
+
+static bool unresolved_predecessor (struct substitution *substitution,
+                                    unsigned lit) {
+  struct ruler *ruler = substitution->simplifier->ruler;
+  struct clauses *clauses = &OCCURRENCES (lit);
+  for (all_clauses (clause, *clauses))
+    if (is_binary_pointer (clause) &&
+        load_color (substitution, NOT (other_pointer (clause))) != INVALID)
+      return true;
+  return false;
+}
+
+static bool unresolved_successor (struct substitution *substitution,
+                                  unsigned lit) {
+  struct ruler *ruler = substitution->simplifier->ruler;
+  struct clauses *clauses = &OCCURRENCES (NOT (lit));
+  for (all_clauses (clause, *clauses))
+    if (is_binary_pointer (clause) &&
+        load_color (substitution, other_pointer (clause)) != INVALID)
+      return true;
+  return false;
+}
+
+static void *trim_and_reset_colors (void *ptr) {
+  struct substitution_worker *worker = ptr;
+  struct substitution *substitution = worker->substitution;
+  unsigned active = 0;
+  for (unsigned lit = worker->begin; lit != worker->end; lit++) {
+    if (load_color (substitution, lit) == INVALID)
+      continue;
+    if (!unresolved_predecessor (substitution, lit) ||
+        !unresolved_successor (substitution, lit))
+      store_color (substitution, lit, INVALID);
+    else {
+      store_color (substitution, lit, lit);
+      active++;
+    }
+  }
+  worker->active = active;
+  return worker;
+}
+
+static void *propagate_colors (void *ptr) {
+  struct substitution_worker *worker = ptr;
+  struct substitution *substitution = worker->substitution;
+  struct ruler *ruler = substitution->simplifier->ruler;
+  bool changed = false;
+  for (unsigned lit = worker->begin; lit != worker->end; lit++) {
+    unsigned color = load_color (substitution, lit);
+    if (color == INVALID)
+      continue;
+    unsigned max_color = color;
+    struct clauses *clauses = &OCCURRENCES (lit);
+    for (all_clauses (clause, *clauses)) {
+      if (!is_binary_pointer (clause))
+        continue;
+      unsigned pred = NOT (other_pointer (clause));
+      unsigned pred_color = load_color (substitution, pred);
+      if (pred_color != INVALID && pred_color > max_color)
+        max_color = pred_color;
+    }
+    if (max_color == color)
+      continue;
+    store_color (substitution, lit, max_color);
+    changed = true;
+  }
+  worker->changed = changed;
+  return worker;
+}
+
+static void *extract_components (void *ptr) {
+  struct substitution_worker *worker = ptr;
+  struct substitution *substitution = worker->substitution;
+  struct ruler *ruler = substitution->simplifier->ruler;
+  struct unsigneds *stack = &worker->stack;
+  struct unsigneds *component = &worker->component;
+  unsigned *repr = substitution->repr;
+  for (unsigned root = worker->begin; root != worker->end; root++) {
+    if (load_color (substitution, root) != root)
+      continue;
+    assert (EMPTY (*stack));
+    CLEAR (*component);
+    store_color (substitution, root, VISITED);
+    PUSH (*stack, root);
+    unsigned new_repr = root;
+    while (!EMPTY (*stack)) {
+      unsigned lit = POP (*stack);
+      PUSH (*component, lit);
+      if (lit < new_repr)
+        new_repr = lit;
+      struct clauses *clauses = &OCCURRENCES (lit);
+      for (all_clauses (clause, *clauses)) {
+        if (!is_binary_pointer (clause))
+          continue;
+        unsigned pred = NOT (other_pointer (clause));
+        if (load_color (substitution, pred) != root)
+          continue;
+        store_color (substitution, pred, VISITED);
+        PUSH (*stack, pred);
+      }
+    }
+    for (all_elements_on_stack (unsigned, lit, *component)) {
+      store_color (substitution, lit, INVALID);
+      if (lit == new_repr)
+        continue;
+      repr[lit] = new_repr;
+      worker->equivalences++;
+      if (lit == NOT (new_repr))
+        worker->complementary = lit;
+    }
+  }
+  return worker;
+}
+
+static unsigned color_components (struct substitution *substitution) {
+  struct simplifier *simplifier = substitution->simplifier;
+  struct ruler *ruler = simplifier->ruler;
+  bool *eliminated = simplifier->eliminated;
+  signed char *values = (signed char *) ruler->values;
+  size_t bytes = 2 * ruler->compact * sizeof *substitution->colors;
+  substitution->colors = allocate_block (bytes);
+  for (all_ruler_literals (lit)) {
+    unsigned color = lit;
+    if (values[lit] || eliminated[IDX (lit)])
+      color = INVALID;
+    store_color (substitution, lit, color);
+  }
+  struct substitution_worker *workers = substitution->workers;
+  unsigned threads = substitution->threads;
+  unsigned equivalences = 0;
+  for (unsigned round = 0; round != MAX_COLORING_ROUNDS; round++) {
+    run_substitution_workers (substitution, trim_and_reset_colors);
+    unsigned active = 0;
+    for (unsigned id = 0; id != threads; id++)
+      active += workers[id].active;
+#ifndef QUIET
+    substitution->rounds = round + 1;
+    substitution->remaining = active;
+#endif
+    if (!active)
+      break;
+    for (unsigned sweeps = 0;; sweeps++) {
+      if (sweeps == MAX_COLORING_SWEEPS)
+        return equivalences;
+      run_substitution_workers (substitution, propagate_colors);
+      bool changed = false;
+      for (unsigned id = 0; !changed && id != threads; id++)
+        changed = workers[id].changed;
+      if (!changed)
+        break;
+    }
+    for (unsigned id = 0; id != threads; id++)
+      workers[id].complementary = INVALID;
+    run_substitution_workers (substitution, extract_components);
+    for (unsigned id = 0; id != threads; id++) {
+      struct substitution_worker *worker = workers + id;
+      equivalences += worker->equivalences;
+      worker->equivalences = 0;
+      if (worker->complementary == INVALID)
+        continue;
+      if (ruler->inconsistent)
+        continue;
+      complementary_equivalence (ruler, worker->complementary);
+    }
+    if (ruler->inconsistent)
+      break;
+  }
+  return equivalences;
+}
+
+static bool resolved (struct substitution *substitution, unsigned lit) {
+  return substitution->colors && load_color (substitution, lit) == INVALID;
+}
+
+static unsigned *find_equivalent_literals (struct substitution *substitution,
                                            unsigned round) {
+  struct simplifier *simplifier = substitution->simplifier;
   struct ruler *ruler = simplifier->ruler;
   size_t bytes = 2 * ruler->compact * sizeof (unsigned);
-  unsigned *marks = allocate_and_clear_block (bytes);
-  unsigned *reaches = allocate_and_clear_block (bytes);
   unsigned *repr = allocate_block (bytes);
   for (all_ruler_literals (lit))
     repr[lit] = lit;
+  substitution->repr = repr;
+  unsigned equivalences = 0;
+  if (substitution->threads > 1)
+    equivalences = color_components (substitution);
+  if (ruler->inconsistent)
+    goto INCONSISTENT;
+  unsigned *marks = allocate_and_clear_block (bytes);
+  unsigned *reaches = allocate_and_clear_block (bytes);
   struct unsigneds scc;
   struct unsigneds work;
   INIT (scc);
   INIT (work);
   bool *eliminated = simplifier->eliminated;
   signed char *values = (signed char *) ruler->values;
-  unsigned marked = 0, equivalences = 0;
+  unsigned marked = 0;
   for (all_ruler_literals (root)) {
     if (eliminated[IDX (root)])
       continue;
@@ -28,6 +336,8 @@ static unsigned *find_equivalent_literals (struct simplifier *simplifier,
       continue;
     if (marks[root])
       continue;
+    if (resolved (substitution, root))
+      continue;
     assert (EMPTY (scc));
     assert (EMPTY (work));
     assert (marked < UINT_MAX);
@@ -47,6 +357,8 @@ static unsigned *find_equivalent_literals (struct simplifier *simplifier,
             continue;
           if (eliminated[IDX (other)])
             continue;
+          if (resolved (substitution, other))
+            continue;
           unsigned other_reaches = reaches[other];
           if (other_reaches < lit_reaches)
             lit_reaches = other_reaches;
@@ -70,11 +382,7 @@ static unsigned *find_equivalent_literals (struct simplifier *simplifier,
           ROG ("literal %s is equivalent to representative %s",
                ROGLIT (other), ROGLIT (new_repr));
           if (other == NOT (new_repr)) {
-            very_verbose (0, "%s", "empty resolvent");
-            trace_add_unit (&ruler->trace, other);
-            assign_ruler_unit (ruler, other);
-            trace_add_empty (&ruler->trace);
-            ruler->inconsistent = true;
+            complementary_equivalence (ruler, other);
             goto DONE;
           }
         }
@@ -98,6 +406,8 @@ static unsigned *find_equivalent_literals (struct simplifier *simplifier,
             continue;
           if (marks[other])
             continue;
+          if (resolved (substitution, other))
+            continue;
           PUSH (work, other);
         }
       }
@@ -108,92 +418,172 @@ DONE:
   RELEASE (work);
   free (reaches);
   free (marks);
+INCONSISTENT:
+#ifndef QUIET
+  if (substitution->threads > 1)
+    verbose (0,
+             "[%u] colored components in %u rounds with %u threads "
+             "leaving %u literals %.0f%%",
+             round, substitution->rounds, substitution->threads,
+             substitution->remaining,
+             percent (substitution->remaining, 2 * ruler->compact));
+#endif
   verbose (0, "[%u] found %u new equivalent literal pairs", round,
            equivalences);
   if (equivalences && !ruler->inconsistent)
     return repr;
   free (repr);
+  substitution->repr = 0;
   return 0;
 }
 
-static void substitute_clause (struct simplifier *simplifier, unsigned src,
-                               unsigned dst, struct clause *clause) {
+/*------------------------------------------------------------------------*/
+
+static bool substitute_literal (struct substitution_worker *worker,
+                                signed char *values, unsigned lit) {
+  unsigned *repr = worker->substitution->repr;
+  unsigned mapped = repr[lit];
+  signed char value = values[mapped];
+  if (value > 0)
+    return false;
+  if (value < 0)
+    return true;
+  signed char *marks = worker->marks;
+  if (marks[mapped])
+    return true;
+  if (marks[NOT (mapped)])
+    return false;
+  marks[mapped] = 1;
+  PUSH (worker->resolvents, mapped);
+  return true;
+}
+
+static void substitute_clause (struct substitution_worker *worker,
+                               signed char *values, unsigned lit,
+                               struct clause *clause) {
+  struct unsigneds *resolvents = &worker->resolvents;
+  size_t start = SIZE (*resolvents);
+  bool keep;
+  if (is_binary_pointer (clause))
+    keep = substitute_literal (worker, values, lit) &&
+           substitute_literal (worker, values, other_pointer (clause));
+  else {
+    keep = true;
+    for (all_literals_in_clause (other, clause))
+      if (!(keep = substitute_literal (worker, values, other)))
+        break;
+  }
+  signed char *marks = worker->marks;
+  unsigned *begin = resolvents->begin + start;
+  for (unsigned *p = begin; p != resolvents->end; p++)
+    marks[*p] = 0;
+  if (keep) {
+    PUSH (*resolvents, INVALID);
+    PUSH (worker->substituted, clause);
+  } else {
+    resolvents->end = begin;
+    PUSH (worker->deleted, clause);
+  }
+}
+
+static bool substituted_first (unsigned *repr, unsigned lit,
+                               struct clause *clause) {
+  if (is_binary_pointer (clause)) {
+    unsigned other = other_pointer (clause);
+    return repr[other] == other || lit < other;
+  }
+  if (clause->garbage)
+    return false;
+  for (all_literals_in_clause (other, clause))
+    if (other < lit && repr[other] != other)
+      return false;
+  return true;
+}
+
+static void *substitute_clauses (void *ptr) {
+  struct substitution_worker *worker = ptr;
+  struct substitution *substitution = worker->substitution;
+  struct simplifier *simplifier = substitution->simplifier;
   struct ruler *ruler = simplifier->ruler;
-  ROGCLAUSE (clause, "substituting");
+  if (worker->id)
+    worker->marks = allocate_and_clear_block (2 * ruler->compact);
+  else
+    worker->marks = simplifier->marks;
   signed char *values = (signed char *) ruler->values;
-  signed char dst_value = values[dst];
-  if (dst_value > 0) {
-    ROG ("satisfied replacement literal %s", ROGLIT (dst));
-    return;
+  unsigned *repr = substitution->repr;
+  for (unsigned lit = worker->begin; lit != worker->end; lit++) {
+    if (repr[lit] == lit)
+      continue;
+    struct clauses *clauses = &OCCURRENCES (lit);
+    for (all_clauses (clause, *clauses))
+      if (substituted_first (repr, lit, clause))
+        substitute_clause (worker, values, lit, clause);
   }
-  struct unsigneds *resolvent = &simplifier->resolvent;
-  CLEAR (*resolvent);
-  unsigned not_dst = NOT (dst);
+  return worker;
+}
+
+static void delete_substituted_clause (struct substitution *substitution,
+                                       struct clause *clause) {
+  struct simplifier *simplifier = substitution->simplifier;
+  struct ruler *ruler = simplifier->ruler;
+  unsigned *repr = substitution->repr;
   if (is_binary_pointer (clause)) {
-    assert (lit_pointer (clause) == src);
+    assert (!redundant_pointer (clause));
+    unsigned lit = lit_pointer (clause);
     unsigned other = other_pointer (clause);
-    if (other == not_dst) {
-      ROG ("resulting clause tautological since it "
-           "contains both %s and %s",
-           ROGLIT (dst), ROGLIT (other));
-      return;
-    }
-    if (other != dst) {
-      signed char other_value = values[other];
-      if (other_value > 0) {
-        ROG ("clause already satisfied by %s", ROGLIT (other));
-        return;
-      }
-      if (!other_value)
-        PUSH (*resolvent, other);
+    assert (repr[lit] != lit);
+    if (repr[other] == other) {
+      struct clause *other_clause = tag_binary (false, other, lit);
+      disconnect_literal (ruler, other, other_clause);
+      mark_eliminate_literal (simplifier, other);
     }
+    ROGBINARY (lit, other, "substituted and deleted");
+    assert (ruler->statistics.binaries);
+    ruler->statistics.binaries--;
+    trace_delete_binary (&ruler->trace, lit, other);
   } else {
-    assert (!clause->garbage);
-    for (all_literals_in_clause (other, clause)) {
-      if (other == src)
-        continue;
-      if (other == dst)
-        continue;
-      if (other == not_dst) {
-        ROG ("resulting clause tautological since it "
-             "contains both %s and %s",
-             ROGLIT (dst), ROGLIT (other));
-        return;
-      }
-      signed char other_value = values[other];
-      if (other_value < 0)
-        continue;
-      if (other_value > 0) {
-        ROG ("clause already satisfied by %s", ROGLIT (other));
-        return;
-      }
-      PUSH (*resolvent, other);
-    }
+    ROGCLAUSE (clause, "substituted and marking garbage");
+    trace_delete_clause (&ruler->trace, clause);
+    ruler->statistics.garbage++;
+    clause->garbage = true;
+    for (all_literals_in_clause (other, clause))
+      if (repr[other] == other)
+        mark_eliminate_literal (simplifier, other);
   }
-  if (!dst_value)
-    PUSH (*resolvent, dst);
-  add_resolvent (simplifier);
 }
 
-static void substitute_literal (struct simplifier *simplifier, unsigned src,
-                                unsigned dst) {
+static void add_substituted_clauses (struct substitution_worker *worker) {
+  struct substitution *substitution = worker->substitution;
+  struct simplifier *simplifier = substitution->simplifier;
   struct ruler *ruler = simplifier->ruler;
-  assert (!ruler->values[src]);
-  ROG ("substituting literal %s with %s", ROGLIT (src), ROGLIT (dst));
-  assert (!simplifier->eliminated[IDX (src)]);
-  assert (!simplifier->eliminated[IDX (dst)]);
-  assert (src != NOT (dst));
-  assert (dst < src);
-  struct clauses *clauses = &OCCURRENCES (src);
-  for (all_clauses (clause, *clauses)) {
-    if (!is_binary_pointer (clause) && clause->garbage)
-      continue;
-    substitute_clause (simplifier, src, dst, clause);
+  signed char *values = (signed char *) ruler->values;
+  struct unsigneds *resolvent = &simplifier->resolvent;
+  unsigned *p = worker->resolvents.begin;
+  for (all_clauses (clause, worker->substituted)) {
+    ROGCLAUSE (clause, "substituting");
+    CLEAR (*resolvent);
+    bool satisfied = false;
+    for (unsigned lit; (lit = *p++) != INVALID;) {
+      signed char value = values[lit];
+      if (value > 0)
+        satisfied = true;
+      else if (!value)
+        PUSH (*resolvent, lit);
+    }
+    if (!satisfied)
+      add_resolvent (simplifier);
+    delete_substituted_clause (substitution, clause);
     if (ruler->inconsistent)
-      break;
-    recycle_clause (simplifier, clause, src);
+      return;
   }
-  RELEASE (*clauses);
+  for (all_clauses (clause, worker->deleted))
+    delete_substituted_clause (substitution, clause);
+}
+
+static void eliminate_substituted_literal (struct simplifier *simplifier,
+                                           unsigned src, unsigned dst) {
+  struct ruler *ruler = simplifier->ruler;
+  RELEASE (OCCURRENCES (src));
   struct unsigneds *extension = &ruler->extension[0];
   ROGBINARY (NOT (src), dst,
              "pushing on extension stack with witness literal %s",
@@ -202,21 +592,13 @@ static void substitute_literal (struct simplifier *simplifier, unsigned src,
   PUSH (*extension, INVALID);
   PUSH (*extension, unmap_literal (unmap, src));
   PUSH (*extension, unmap_literal (unmap, NOT (dst)));
-  if (SGN (src)) {
-    unsigned idx = IDX (src);
-    ROG ("marking %s as aliminated", ROGVAR (idx));
-    ruler->statistics.substituted++;
-    assert (ruler->statistics.active);
-    ruler->statistics.active--;
-    assert (!simplifier->eliminated[idx]);
-    simplifier->eliminated[idx] = 1;
-  }
 }
 
 static unsigned
-substitute_equivalent_literals (struct simplifier *simplifier,
-                                unsigned *repr) {
+substitute_equivalent_literals (struct substitution *substitution) {
+  struct simplifier *simplifier = substitution->simplifier;
   struct ruler *ruler = simplifier->ruler;
+  unsigned *repr = substitution->repr;
 
   unsigned other;
   if (ruler->options.proof.file)
@@ -226,31 +608,34 @@ substitute_equivalent_literals (struct simplifier *simplifier,
         trace_add_binary (&ruler->trace, lit, NOT (other));
       }
 
-  unsigned substituted = 0;
-  signed char *values = (signed char *) ruler->values;
-  for (all_ruler_indices (idx)) {
-    if (ruler->terminate)
-      break;
-    unsigned lit = LIT (idx);
-    if (values[lit])
-      continue;
-    unsigned other = repr[lit];
-    if (other == lit)
-      continue;
-    substitute_literal (simplifier, lit, other);
-    substituted++;
-    if (ruler->inconsistent)
-      break;
-    if (values[lit])
-      continue;
-    unsigned not_lit = NOT (lit);
-    unsigned not_other = NOT (other);
-    assert (repr[not_lit] == not_other);
-    substitute_literal (simplifier, not_lit, not_other);
+  run_substitution_workers (substitution, substitute_clauses);
+  for (unsigned id = 0; id != substitution->threads; id++) {
+    add_substituted_clauses (substitution->workers + id);
     if (ruler->inconsistent)
       break;
   }
 
+  unsigned substituted = 0;
+  if (!ruler->inconsistent)
+    for (all_ruler_indices (idx)) {
+      unsigned lit = LIT (idx);
+      if ((other = repr[lit]) == lit)
+        continue;
+      ROG ("substituted literal %s with %s", ROGLIT (lit), ROGLIT (other));
+      assert (!ruler->values[lit]);
+      assert (!simplifier->eliminated[idx]);
+      assert (!simplifier->eliminated[IDX (other)]);
+      assert (other < lit);
+      eliminate_substituted_literal (simplifier, lit, other);
+      eliminate_substituted_literal (simplifier, NOT (lit), NOT (other));
+      ROG ("marking %s as aliminated", ROGVAR (idx));
+      ruler->statistics.substituted++;
+      assert (ruler->statistics.active);
+      ruler->statistics.active--;
+      simplifier->eliminated[idx] = 1;
+      substituted++;
+    }
+
   if (ruler->options.proof.file)
     for (all_positive_ruler_literals (lit))
       if ((other = repr[lit]) != lit) {
@@ -265,22 +650,30 @@ substitute_equivalent_literals (struct simplifier *simplifier,
 
 bool equivalent_literal_substitution (struct simplifier *simplifier,
                                       unsigned round) {
-#ifndef QUIET
   struct ruler *ruler = simplifier->ruler;
+#ifndef QUIET
   double substitution_start = START (ruler, substitute);
+  double scc_start = START (ruler, scc);
 #endif
   message (0, 0);
-  unsigned *repr = find_equivalent_literals (simplifier, round);
+  struct substitution substitution;
+  init_substitution (&substitution, simplifier);
+  unsigned *repr = find_equivalent_literals (&substitution, round);
+#ifndef QUIET
+  double scc_end = STOP (ruler, scc);
+#endif
   unsigned substituted = 0;
-  if (repr) {
-    substituted = substitute_equivalent_literals (simplifier, repr);
-    free (repr);
-  }
+  if (repr && !ruler->terminate)
+    substituted = substitute_equivalent_literals (&substitution);
+  free (repr);
+  release_substitution (&substitution);
 #ifndef QUIET
   double substitution_end = STOP (ruler, substitute);
-  message (0, "[%u] substituted %u variables %.0f%% in %.2f seconds", round,
-           substituted, percent (substituted, ruler->size),
-           substitution_end - substitution_start);
+  message (0,
+           "[%u] substituted %u variables %.0f%% in %.2f seconds "
+           "(%.2f seconds components)",
+           round, substituted, percent (substituted, ruler->size),
+           substitution_end - substitution_start, scc_end - scc_start);
 #endif
   return substituted;
 }
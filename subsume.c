@@ -129,6 +129,7 @@ strengthen_ternary_clause (struct simplifier *simplifier,
                            struct clause *clause, unsigned remove) {
   assert (!is_binary_pointer (clause));
   assert (clause->size == 3);
+  assert (!clause->compressed);
   assert (remove != INVALID);
   unsigned lit = INVALID, other = INVALID;
   unsigned *literals = clause->literals;
@@ -159,13 +160,19 @@ strengthen_ternary_clause (struct simplifier *simplifier,
   return tag_binary (false, lit, other);
 }
 
-static void strengthen_very_large_clause (struct simplifier *simplifier,
-                                          struct clause *clause,
-                                          unsigned remove) {
+static struct clause *
+strengthen_very_large_clause (struct simplifier *simplifier,
+                              struct clause *clause, unsigned remove) {
   struct ruler *ruler = simplifier->ruler;
   ROGCLAUSE (clause, "strengthening by removing %s in", ROGLIT (remove));
   assert (!is_binary_pointer (clause));
   assert (remove != INVALID);
+  struct clause *copy = unshare_ruler_clause (ruler, clause);
+  if (copy != clause) {
+    PUSH (ruler->clauses, copy);
+    clause = copy;
+  }
+  assert (!clause->compressed);
   unsigned old_size = clause->size;
   assert (old_size > 3);
   unsigned *literals = clause->literals, *q = literals;
@@ -181,6 +188,7 @@ static void strengthen_very_large_clause (struct simplifier *simplifier,
   assert (new_size > 2);
   ruler->statistics.strengthened++;
   mark_subsume_clause (simplifier, clause);
+  return clause;
 }
 
 static void forward_subsume_large_clause (struct simplifier *simplifier,
@@ -234,7 +242,7 @@ REENTER:;
         clause = strengthen_ternary_clause (simplifier, clause, remove);
         assert (is_binary_pointer (clause));
       } else
-        strengthen_very_large_clause (simplifier, clause, remove);
+        clause = strengthen_very_large_clause (simplifier, clause, remove);
       ROGCLAUSE (clause, "strengthened");
       mark_eliminate_literal (simplifier, remove);
       unmark_literal (simplifier->marks, remove);
@@ -304,7 +312,7 @@ flush_large_garbage_clauses_and_reconnect (struct ruler *ruler) {
     struct clause *clause = *q++ = *p++;
     if (clause->garbage) {
       ROGCLAUSE (clause, "finally deleting");
-      free (clause);
+      (void) dereference_ruler_clause (ruler, clause);
 #ifndef QUIET
       flushed++;
 #endif
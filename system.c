@@ -71,6 +71,31 @@ size_t current_resident_set_size (void) {
 
 #endif
 
+#ifndef QUIET
+
+#ifdef __linux__
+
+size_t transparent_huge_pages_size (void) {
+  FILE *file = fopen ("/proc/self/smaps_rollup", "r");
+  if (!file)
+    return 0;
+  char line[128];
+  size_t res = 0;
+  while (fgets (line, sizeof line, file))
+    if (sscanf (line, "AnonHugePages: %zu kB", &res) == 1)
+      break;
+  fclose (file);
+  return res << 10;
+}
+
+#else
+
+size_t transparent_huge_pages_size (void) { return 0; }
+
+#endif
+
+#endif
+
 void summarize_used_resources (unsigned t) {
   assert (t);
   double w = current_time () - start_time;
@@ -14,6 +14,7 @@ double process_time (void);
 double wall_clock_time (void);
 size_t maximum_resident_set_size (void);
 size_t current_resident_set_size (void);
+size_t transparent_huge_pages_size (void);
 
 #endif
 
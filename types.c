@@ -3,7 +3,6 @@
 #include "message.h"
 #include "options.h"
 #include "variable.h"
-#include "walk.h"
 #include "watches.h"
 
 #include <stdatomic.h>
@@ -61,7 +60,6 @@ void check_types (void) {
   if (verbosity > 0) {
     fputs ("c\n", stdout);
     printf ("c sizeof (struct clause) = %zu\n", sizeof (struct clause));
-    printf ("c sizeof (struct counter) = %zu\n", sizeof (struct counter));
     printf ("c sizeof (struct phases) = %zu\n", sizeof (struct phases));
     printf ("c sizeof (struct variable) = %zu\n", sizeof (struct variable));
     printf ("c sizeof (struct watcher) = %zu\n", sizeof (struct watcher));
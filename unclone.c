@@ -1,19 +1,12 @@
 #include "unclone.h"
+#include "import.h"
 #include "message.h"
 #include "ruler.h"
 
 static void save_ring_binaries (struct ring *ring) {
   struct ruler *ruler = ring->ruler;
-  if (!ring->id) {
-    assert (!ruler->occurrences);
-    assert (ruler->compact == ring->size);
-    ruler->occurrences = allocate_and_clear_array (
-        2 * ring->size, sizeof *ruler->occurrences);
-  }
-
   struct saved_watchers *saved = &ring->saved;
   assert (EMPTY (*saved));
-  size_t irredundant = 0;
 
   for (all_ring_literals (lit)) {
     struct references *references = &REFERENCES (lit);
@@ -31,27 +24,14 @@ static void save_ring_binaries (struct ring *ring) {
       PUSH (*saved, sw);
     }
     RELEASE (*references);
-    if (ring->id)
-      continue;
-    unsigned *binaries = references->binaries;
-    if (!binaries)
-      continue;
-    struct clauses *occurrenes = &OCCURRENCES (lit);
-    for (unsigned *p = binaries, other; (other = *p) != INVALID; p++) {
-      struct clause *clause = tag_binary (false, lit, other);
-      PUSH (*occurrenes, clause);
-      if (lit < other)
-        irredundant++;
+    if (!ring->id) {
+      free (BINARIES (lit));
+      BINARIES (lit) = 0;
     }
-    free (binaries);
   }
 
   size_t redundant = SIZE (*saved);
-
-  if (ring->id)
-    irredundant = ruler->statistics.binaries;
-  else
-    assert (irredundant == ruler->statistics.binaries);
+  size_t irredundant = ruler->reclone.binaries;
 
   very_verbose (ring, "saved %zu binary redundant watches", redundant);
   very_verbose (ring, "flushed %zu binary irredundant watches",
@@ -64,16 +44,14 @@ static void save_ring_binaries (struct ring *ring) {
   ring->statistics.redundant -= redundant;
 }
 
+// The irredundant clauses have been shared with the ruler before
+// simplification (see 'reclone.c') and thus all rings just drop their
+// references to them.
+
 static void save_large_watched_clauses (struct ring *ring) {
-  struct ruler *ruler = ring->ruler;
-  struct clauses *clauses = &ruler->clauses;
-  assert (ring->id || EMPTY (*clauses));
   struct saved_watchers *save = &ring->saved;
 #ifndef QUIET
-  size_t collected = 0, saved = 0;
-#endif
-#if !defined(QUIET) || !defined(NDEBUG)
-  size_t transferred = 0, flushed = 0;
+  size_t collected = 0, saved = 0, flushed = 0;
 #endif
   for (all_watchers (watcher)) {
     struct clause *clause = watcher->clause;
@@ -84,41 +62,33 @@ static void save_large_watched_clauses (struct ring *ring) {
 #endif
     } else {
       if (watcher->redundant) {
+        if (watcher->imported)
+          retire_imported_watcher (ring, watcher);
         struct saved_watcher sw = saved_watcher_from_watcher (watcher);
         PUSH (*save, sw);
 #ifndef QUIET
         saved++;
 #endif
-      } else if (ring->id) {
+      } else {
         dereference_clause (ring, clause);
-#if !defined(QUIET) || !defined(NDEBUG)
+#ifndef QUIET
         flushed++;
-#endif
-      } else {
-        PUSH (*clauses, clause);
-#if !defined(QUIET) || !defined(NDEBUG)
-        transferred++;
 #endif
       }
       dec_clauses (ring, watcher->redundant);
     }
   }
   RESIZE (ring->watchers, 1);
+  ring->garbage = 0;
   very_verbose (ring, "saved %zu redundant large watches", saved);
   very_verbose (ring, "collected %zu large watches", collected);
-  if (ring->id) {
-    assert (!transferred);
-    very_verbose (ring, "flushed %zu irredundant large watches", flushed);
-  } else {
-    assert (!flushed);
-    very_verbose (ring, "transferred %zu irredundant large clauses",
-                  transferred);
-  }
+  very_verbose (ring, "flushed %zu irredundant large watches", flushed);
 }
 
 void unclone_ring (struct ring *ring) {
   save_ring_binaries (ring);
   save_large_watched_clauses (ring);
+  clear_segments (ring);
   reset_last_learned (ring);
   assert (SIZE (ring->watchers) == 1);
   release_ring (ring, true);
@@ -27,6 +27,11 @@ static char * compact_usage =
 "  --conflicts=0...              limit conflicts (unlimited by default)\n"
 "  --threads=1..65536            set number of threads (default '1')\n"
 "  --time=1...                   limit time in seconds (unlimited by default)\n"
+"  --monitor=<socket>            serve live ring snapshots on Unix socket\n"
+#ifndef QUIET
+"  --scaling=<threads>,...       in-process benchmark for thread counts\n"
+"  --stats-json=<file>           write statistics and samples as JSON lines\n"
+#endif
 "\n"
 "and '<dimacs>' is the input file in 'DIMACS' format ('<stdin>' if missing)\n"
 "and '<proof>' the proof trace file in 'DRAT' format (no proof if missing).\n"
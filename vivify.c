@@ -106,6 +106,43 @@ static inline bool watched_vivification_candidate (struct ring *ring,
   return true;
 }
 
+// Irredundant clauses are shared among all rings.  In order to avoid
+// vivifying the same clause in every ring they are partitioned into slices
+// by hashing their size and first literals (which rings never reorder) and
+// each searching ring only tries the clauses of its own slice.  Dedicated
+// walker rings never vivify and have the largest ids, so they get no
+// slice.  The 'vivified' flag of an irredundant clause marks it as tried
+// (see the comment in 'vivify_watcher' on why writing it is sane) and is
+// reset after simplification by 'share_ring_clauses_with_ruler'.  As
+// slices are disjoint, an irredundant candidate which is already vivified
+// was tried by the same ring before and is counted as 'retried', while
+// 'duplicated' only counts redundant clauses vivified by several rings.
+
+static inline unsigned vivification_slice (struct ring *ring,
+                                           struct clause *clause) {
+  struct ruler *ruler = ring->ruler;
+  unsigned searching = SIZE (ruler->rings) - ruler->walkers;
+  assert (searching);
+  unsigned hash = clause->size;
+  hash = 1000000007u * hash + clause->literals[0];
+  hash = 1000000007u * hash + clause->literals[1];
+  return hash % searching;
+}
+
+static inline bool
+watched_irredundant_vivification_candidate (struct ring *ring,
+                                            struct watcher *watcher) {
+  if (watcher->garbage)
+    return false;
+  assert (!watcher->redundant);
+  struct clause *clause = watcher->clause;
+  if (clause->garbage)
+    return false;
+  if (clause->vivified)
+    return false;
+  return vivification_slice (ring, clause) == ring->id;
+}
+
 static void schedule_vivification_candidate (struct ring *ring,
                                              unsigned *counts,
                                              struct unsigneds *candidates,
@@ -115,7 +152,8 @@ static void schedule_vivification_candidate (struct ring *ring,
   for (all_watcher_literals (lit, candidate))
     if (values[lit] > 0) {
       LOGCLAUSE (candidate->clause, "root-level satisfied");
-      mark_garbage_watcher (ring, candidate);
+      if (candidate->redundant)
+        mark_garbage_watcher (ring, candidate);
       return;
     }
   for (all_watcher_literals (lit, candidate))
@@ -201,15 +239,12 @@ static void sort_vivivification_candidates (struct ring *ring,
     } else {
       struct clause *clause = watcher->clause;
       assert (clause->size > SIZE_WATCHER_LITERALS);
-      unsigned *src = clause->literals;
-      unsigned *end_src = src + clause->size;
       unsigned *dst = watcher->aux;
       unsigned *end_dst = dst + SIZE_WATCHER_LITERALS;
       unsigned last = INVALID;
       for (unsigned *q = dst; q != end_dst; q++) {
         unsigned next = INVALID;
-        for (unsigned *p = src; p != end_src; p++) {
-          unsigned other = *p;
+        for (all_literals_in_clause (other, clause)) {
           if (last == INVALID ||
               better_vivification_literal (counts, last, other))
             if (next == INVALID ||
@@ -265,15 +300,34 @@ static void sort_vivivification_candidates (struct ring *ring,
   }
 }
 
+static bool vivification_candidate (struct ring *ring,
+                                    struct watcher *watcher,
+                                    unsigned tier) {
+  if (tier)
+    return watched_vivification_candidate (ring, watcher, tier);
+  return watched_irredundant_vivification_candidate (ring, watcher);
+}
+
+static struct watcher *first_vivification_watcher (struct ring *ring,
+                                                   unsigned tier) {
+  return ring->watchers.begin + (tier ? ring->redundant : 1);
+}
+
+static struct watcher *last_vivification_watcher (struct ring *ring,
+                                                  unsigned tier) {
+  return tier ? ring->watchers.end : ring->watchers.begin + ring->redundant;
+}
+
 static size_t reschedule_vivification_candidates (struct vivifier *vivifier,
                                                   unsigned tier) {
   struct unsigneds *candidates = &vivifier->candidates;
   unsigned *counts = vivifier->counts;
   struct ring *ring = vivifier->ring;
   assert (EMPTY (*candidates));
-  for (all_redundant_watchers (watcher))
-    if (watcher->vivify &&
-        watched_vivification_candidate (ring, watcher, tier))
+  struct watcher *begin = first_vivification_watcher (ring, tier);
+  struct watcher *end = last_vivification_watcher (ring, tier);
+  for (struct watcher *watcher = begin; watcher != end; watcher++)
+    if (watcher->vivify && vivification_candidate (ring, watcher, tier))
       schedule_vivification_candidate (ring, counts, candidates, watcher);
   size_t size = SIZE (*candidates);
   sort_vivivification_candidates (ring, counts, size, candidates->begin);
@@ -287,9 +341,10 @@ static size_t schedule_vivification_candidates (struct vivifier *vivifier,
   struct ring *ring = vivifier->ring;
   memset (counts, 0, sizeof (unsigned) * 2 * ring->size);
   size_t before = SIZE (*candidates);
-  for (all_redundant_watchers (watcher))
-    if (!watcher->vivify &&
-        watched_vivification_candidate (ring, watcher, tier))
+  struct watcher *begin = first_vivification_watcher (ring, tier);
+  struct watcher *end = last_vivification_watcher (ring, tier);
+  for (struct watcher *watcher = begin; watcher != end; watcher++)
+    if (!watcher->vivify && vivification_candidate (ring, watcher, tier))
       schedule_vivification_candidate (ring, counts, candidates, watcher);
   size_t after = SIZE (*candidates);
   size_t delta = after - before;
@@ -474,7 +529,7 @@ static void vivify_learn (struct vivifier *vivifier,
     struct watcher *watcher = get_watcher (ring, candidate);
     unsigned glue = SIZE (*levels);
     LOG ("computed glue %u", glue);
-    if (glue > watcher->glue) {
+    if (watcher->redundant && glue > watcher->glue) {
       glue = watcher->glue;
       LOG ("but candidate glue %u smaller", glue);
     }
@@ -509,9 +564,14 @@ static void vivify_watcher (struct vivifier *vivifier, unsigned tier,
   assert (SIZE (*decisions) == ring->level);
 
   struct watcher *watcher = index_to_watcher (ring, idx);
+  bool redundant = watcher->redundant;
+  assert (redundant == (tier > 0));
   if (watcher->clause->vivified) {
     LOGCLAUSE (watcher->clause, "already vivified");
-    mark_garbage_watcher (ring, watcher);
+    if (redundant)
+      mark_garbage_watcher (ring, watcher);
+    else
+      ring->statistics.vivify.retried++;
     return;
   }
   watcher->vivify = false;
@@ -528,7 +588,8 @@ static void vivify_watcher (struct vivifier *vivifier, unsigned tier,
       struct variable *v = VAR (lit);
       if (!v->level) {
         LOGCLAUSE (clause, "root-level satisfied");
-        mark_garbage_watcher (ring, watcher);
+        if (redundant)
+          mark_garbage_watcher (ring, watcher);
         return;
       }
       struct watch *reason = v->reason;
@@ -550,6 +611,10 @@ static void vivify_watcher (struct vivifier *vivifier, unsigned tier,
 
   LOGCLAUSE (clause, "trying to vivify watcher[%u]", idx);
   ring->statistics.vivify.tried++;
+  if (!redundant) {
+    ring->statistics.vivify.irredundant++;
+    clause->vivified = true;
+  }
 
   for (unsigned level = 0; level != SIZE (*decisions); level++) {
     unsigned decision = decisions->begin[level];
@@ -661,7 +726,13 @@ static void vivify_watcher (struct vivifier *vivifier, unsigned tier,
 
   bool import_before_next_vivification = false;
 
-  if (subsuming) {
+  // Irredundant clauses are shared with the ruler and all other rings and
+  // thus can not be removed here.  Only strengthening them is useful,
+  // which adds (and exports) the strengthened clause as redundant clause.
+
+  if (subsuming && !redundant)
+    LOGCLAUSE (clause, "irredundant vivification candidate subsumed");
+  else if (subsuming) {
     ring->statistics.vivify.succeeded++;
     ring->statistics.vivify.subsumed++;
     LOGWATCH (candidate, "vivify subsumed");
@@ -685,7 +756,8 @@ static void vivify_watcher (struct vivifier *vivifier, unsigned tier,
     LOGWATCH (candidate, "vivify strengthening");
     (void) vivify_learn (vivifier, candidate);
     watcher = index_to_watcher (ring, idx);
-    mark_garbage_watcher (ring, watcher);
+    if (redundant)
+      mark_garbage_watcher (ring, watcher);
 
     // This is the single unprotected write access to clause data
     // in parallel and thus in principle is a data race.  On the
@@ -702,8 +774,13 @@ static void vivify_watcher (struct vivifier *vivifier, unsigned tier,
     // However, if long imported clause glues are increased to MAX_GLUE in
     // the watcher (when watching them) other threads would never try to
     // vivify this clause.  If it is just increased by one it happens.
+    // Then the work of this ring was duplicated if the flag is already set.
 
-    watcher->clause->vivified = true;
+    if (redundant) {
+      if (watcher->clause->vivified)
+        ring->statistics.vivify.duplicated++;
+      watcher->clause->vivified = true;
+    }
 
     // In any case trigger import of new clauses as strengthening and
     // exporting a clause does not happen too frequently and can be
@@ -712,7 +789,7 @@ static void vivify_watcher (struct vivifier *vivifier, unsigned tier,
 
     import_before_next_vivification = true;
 
-  } else if (implied != INVALID) {
+  } else if (implied != INVALID && redundant) {
     ring->statistics.vivify.succeeded++;
     ring->statistics.vivify.implied++;
     LOGCLAUSE (watcher->clause, "vivify implied");
@@ -745,10 +822,15 @@ void vivify_clauses (struct ring *ring) {
            " search ticks",
            delta_probing_ticks, (double) VIVIFY_EFFORT, delta_search_ticks);
 
+  bool irredundant = ring->options.vivify_irredundant;
   double sum = RELATIVE_VIVIFY_TIER1_EFFORT + RELATIVE_VIVIFY_TIER2_EFFORT;
+  if (irredundant)
+    sum += RELATIVE_VIVIFY_IRREDUNDANT_EFFORT;
   uint64_t limit = PROBING_TICKS;
 
-  for (unsigned tier = 1; tier <= 2; tier++) {
+  // Tier 0 denotes the irredundant clauses in the slice of this ring.
+
+  for (unsigned tier = !irredundant; tier <= 2; tier++) {
     if (ring->inconsistent)
       break;
     if (terminate_ring (ring))
@@ -757,8 +839,10 @@ void vivify_clauses (struct ring *ring) {
     double effort;
     if (tier == 2)
       effort = RELATIVE_VIVIFY_TIER2_EFFORT;
-    else
+    else if (tier == 1)
       effort = RELATIVE_VIVIFY_TIER1_EFFORT;
+    else
+      effort = RELATIVE_VIVIFY_IRREDUNDANT_EFFORT;
 
     double scale = effort / sum;
     uint64_t scaled_ticks = scale * delta_probing_ticks;
@@ -854,7 +938,8 @@ void vivify_clauses (struct ring *ring) {
                   PROBING_TICKS - probing_ticks_before,
                   (PROBING_TICKS > limit ? "limit hit" : "completed"));
 
-    verbose_report (ring, (tier == 1 ? 'u' : 'v'), !vivified);
+    verbose_report (ring, (tier == 2 ? 'v' : tier == 1 ? 'u' : 'w'),
+                    !vivified);
   }
   STOP (ring, vivify);
 }
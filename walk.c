@@ -2,19 +2,19 @@
 #include "backtrack.h"
 #include "clause.h"
 #include "decide.h"
+#include "import.h"
 #include "logging.h"
 #include "message.h"
 #include "propagate.h"
 #include "random.h"
 #include "ruler.h"
 #include "search.h"
-#include "set.h"
-#include "tagging.h"
 #include "utilities.h"
 #include "warm.h"
 
 #include <assert.h>
 #include <inttypes.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -22,21 +22,63 @@ struct doubles {
   double *begin, *end, *allocated;
 };
 
-struct counters {
-  struct counter **begin, **end, **allocated;
-  unsigned *binaries;
+struct offsets {
+  size_t *begin, *end, *allocated;
 };
 
+// Local search works on a flat copy of the irredundant binary and large
+// clauses, which are identified by 32-bit indices.  The literals of
+// clause 'C' are stored contiguously in 'literals' from 'starts[C]' up to
+// 'starts[C + 1]'.  In the same way the indices of the clauses in which
+// the literal 'LIT' occurs are stored in 'occurrences' from 'occurs[LIT]'
+// up to 'occurs[LIT + 1]'.  Irredundant clauses are shared by all rings
+// and only added and removed during simplification.  Thus these arrays
+// are built once by the first ring walking after a simplification and
+// then shared read-only through the ruler until the next simplification
+// releases them (see 'simplify.c').
+
+struct flat_clauses {
+  unsigned *literals;
+  size_t *starts;
+  unsigned *occurrences;
+  size_t *occurs;
+  size_t bytes;
+  unsigned size;
+};
+
+// Each ring only keeps the true literal 'counts' of the flat clauses.
+// Broken clauses are kept on the dense 'broken' array and 'positions' maps
+// a broken clause to its position in that array, which allows to remove
+// it in constant time and to sample broken clauses uniformly with a single
+// random number.  With 'walk_persistent' this state is kept between walks
+// until the next simplification.  In between clauses can only become
+// satisfied by new root-level units of the ring.  Those clauses are then
+// marked dead, which makes them look satisfied forever.  Each walk then
+// only needs to recompute the counts of the live clauses under the initial
+// assignment of the walk.
+
+struct walking {
+  struct flat_clauses *flat;
+  unsigned *counts;
+  unsigned *positions;
+  unsigned *broken;
+  bool *dead;
+  size_t bytes;
+  unsigned killed;
+  unsigned fixed;
+};
+
+#define DEAD_COUNT (1u << 31)
+
 struct walker {
   struct ring *ring;
-  struct counters *occurrences;
-  struct counter *counters;
-  struct set unsatisfied;
+  struct flat_clauses *flat;
+  struct walking *walking;
   struct unsigneds literals;
   struct unsigneds trail;
-  struct watches saved;
   struct doubles scores;
   struct doubles breaks;
+  unsigned unsatisfied;
   unsigned maxbreak;
   double epsilon;
   size_t minimum;
@@ -47,10 +89,9 @@ struct walker {
   uint64_t flips;
 };
 
-#define COUNTERS(LIT) (walker->occurrences[LIT])
+#define BEGIN_OCCURRENCES(LIT) (flat->occurrences + flat->occurs[LIT])
 
-#define all_counters(ELEM, COUNTERS) \
-  all_pointers_on_stack (struct counter, ELEM, COUNTERS)
+#define END_OCCURRENCES(LIT) (flat->occurrences + flat->occurs[(LIT) + 1])
 
 #ifdef LOGGING
 
@@ -66,24 +107,6 @@ struct walker {
   } while (0)
 #endif
 
-static size_t
-count_irredundant_non_garbage_clauses (struct ring *ring,
-                                       struct clause **last_ptr) {
-  size_t res = 0;
-  struct clause *last = 0;
-  for (all_watchers (watcher)) {
-    if (watcher->garbage)
-      continue;
-    if (watcher->redundant)
-      continue;
-    struct clause *clause = watcher->clause;
-    last = clause;
-    res++;
-  }
-  *last_ptr = last;
-  return res;
-}
-
 static double base_values[][2] = {{0.0, 2.00}, {3.0, 2.50}, {4.0, 2.85},
                                   {5.0, 3.70}, {6.0, 5.10}, {7.0, 7.40}};
 
@@ -126,97 +149,271 @@ static void initialize_break_table (struct walker *walker, double length) {
   WOG ("epsilon score %g of %u break count and more", epsilon, maxbreak);
 }
 
-static void *min_max_tag_binary (bool redundant, unsigned first,
-                                 unsigned second) {
-  assert (first != second);
-  unsigned min = first < second ? first : second;
-  unsigned max = first < second ? second : first;
-  return tag_binary (redundant, min, max);
+void release_flat_clauses (struct ruler *ruler) {
+  struct flat_clauses *flat = ruler->flat;
+  if (!flat)
+    return;
+  free (flat->literals);
+  free (flat->starts);
+  free (flat->occurrences);
+  free (flat->occurs);
+  free (flat);
+  ruler->flat = 0;
 }
 
-static double connect_counters (struct walker *walker,
-                                struct clause *last) {
-  struct ring *ring = walker->ring;
+void release_walking (struct ring *ring) {
+  struct walking *walking = ring->walking;
+  if (!walking)
+    return;
+  free (walking->counts);
+  free (walking->positions);
+  free (walking->broken);
+  free (walking->dead);
+  free (walking);
+  ring->walking = 0;
+}
+
+// Needs root-level values and thus is called before importing decisions.
+// Root-level falsified literals and satisfied clauses of the ring building
+// the flat clauses are not copied.  For other rings these clauses are
+// still implied and only guide the search.
+
+static uint64_t flatten_clauses (struct ring *ring,
+                                 struct unsigneds *literals,
+                                 struct offsets *starts) {
   signed char *values = ring->values;
-  struct counter *p = walker->counters;
-  double sum_lengths = 0;
-  size_t clauses = 0;
   uint64_t ticks = 1;
-  volatile bool *terminate = &ring->ruler->terminate;
-  for (all_watchers (watcher)) {
+  for (all_ring_literals (lit)) {
+    if (values[lit])
+      continue;
     ticks++;
-    if (watcher->garbage)
+    unsigned *binaries = BINARIES (lit);
+    if (!binaries)
       continue;
-    if (watcher->redundant)
+    unsigned *p, other;
+    for (p = binaries; (other = *p) != INVALID; p++) {
+      if (lit > other)
+        continue;
+      signed char value = values[other];
+      if (value > 0)
+        continue;
+      PUSH (*starts, SIZE (*literals));
+      PUSH (*literals, lit);
+      if (!value)
+        PUSH (*literals, other);
+    }
+    ticks += cache_lines (p, binaries);
+  }
+  struct watcher *begin = ring->watchers.begin + 1;
+  struct watcher *end = ring->watchers.begin + ring->redundant;
+  for (struct watcher *watcher = begin; watcher != end; watcher++) {
+    ticks++;
+    if (watcher->garbage)
       continue;
+    assert (!watcher->redundant);
     struct clause *clause = watcher->clause;
-    unsigned length = 0;
+    size_t start = SIZE (*literals);
+    bool satisfied = false;
     ticks++;
-    for (all_literals_in_clause (lit, clause))
-      if (values[lit])
-        length++;
-    if (!length) {
-      LOGCLAUSE (clause, "WARNING: fully assigned");
-      continue;
-    }
-    unsigned count = 0;
     for (all_literals_in_clause (lit, clause)) {
       signed char value = values[lit];
-      if (!value)
+      if (value < 0)
         continue;
-      count += (value > 0);
-      PUSH (walker->occurrences[lit], p);
-      ticks++;
-    }
-    sum_lengths += length;
-    p->count = count;
-    p->clause = clause;
-    if (!count) {
-      set_insert (&walker->unsatisfied, p);
-      LOGCLAUSE (clause, "initially broken");
-      ticks++;
+      if (value > 0) {
+        satisfied = true;
+        break;
+      }
+      PUSH (*literals, lit);
     }
-    clauses++;
-    p++;
-    if (clause == last)
-      break;
-    if (*terminate)
-      break;
+    if (satisfied)
+      literals->end = literals->begin + start;
+    else
+      PUSH (*starts, start);
   }
-  for (all_ring_literals (lit)) {
-    signed char lit_value = values[lit];
-    if (!lit_value)
+  return ticks;
+}
+
+static uint64_t build_flat_clauses (struct ring *ring) {
+  struct ruler *ruler = ring->ruler;
+  assert (!ruler->flat);
+  struct unsigneds literals;
+  struct offsets starts;
+  INIT (literals);
+  INIT (starts);
+  uint64_t ticks = flatten_clauses (ring, &literals, &starts);
+  size_t size = SIZE (starts);
+  if ((unsigned) size != size || size >= UINT_MAX)
+    fatal_error ("too many clauses for local search");
+  PUSH (starts, SIZE (literals));
+
+  unsigned lits = 2 * ring->size;
+  size_t *occurs = allocate_and_clear_array (lits + 1, sizeof *occurs);
+  for (all_elements_on_stack (unsigned, lit, literals))
+    occurs[lit]++;
+  size_t total = 0;
+  for (unsigned lit = 0; lit <= lits; lit++)
+    occurs[lit] = total += occurs[lit];
+  unsigned *occurrences = allocate_array (total, sizeof *occurrences);
+  for (unsigned c = size; c--;) {
+    unsigned *begin = literals.begin + starts.begin[c];
+    unsigned *end = literals.begin + starts.begin[c + 1];
+    for (unsigned *p = begin; p != end; p++)
+      occurrences[--occurs[*p]] = c;
+  }
+  ticks += cache_lines (literals.end, literals.begin);
+  ticks += cache_lines (occurrences + total, occurrences);
+
+  struct flat_clauses *flat = allocate_and_clear_block (sizeof *flat);
+  flat->literals = literals.begin;
+  flat->starts = starts.begin;
+  flat->occurrences = occurrences;
+  flat->occurs = occurs;
+  flat->size = size;
+  flat->bytes = 2 * total * sizeof (unsigned) +
+                (size + 1 + lits + 1) * sizeof (size_t);
+  ruler->flat = flat;
+  ring->statistics.walks.connected++;
+  very_verbose (ring,
+                "flattened %zu clauses with %zu literals in %" PRIu64
+                " ticks shared in %zu bytes",
+                size, total, ticks, flat->bytes);
+  return ticks;
+}
+
+static struct flat_clauses *share_flat_clauses (struct ring *ring,
+                                                uint64_t *ticks) {
+  struct ruler *ruler = ring->ruler;
+  if (pthread_mutex_lock (&ruler->locks.walk))
+    fatal_error ("failed to acquire walk lock during sharing");
+  if (!ruler->flat)
+    *ticks += build_flat_clauses (ring);
+  struct flat_clauses *flat = ruler->flat;
+  if (pthread_mutex_unlock (&ruler->locks.walk))
+    fatal_error ("failed to release walk lock during sharing");
+  return flat;
+}
+
+static void new_walking (struct ring *ring, struct flat_clauses *flat) {
+  assert (!ring->walking);
+  size_t size = flat->size;
+  struct walking *walking = allocate_and_clear_block (sizeof *walking);
+  walking->flat = flat;
+  walking->counts = allocate_array (size, sizeof *walking->counts);
+  walking->positions = allocate_array (size, sizeof *walking->positions);
+  walking->broken = allocate_array (size, sizeof *walking->broken);
+  walking->dead = allocate_and_clear_array (size, sizeof *walking->dead);
+  walking->fixed = INVALID; // Forces to kill satisfied clauses first.
+  walking->bytes = size * (3 * sizeof (unsigned) + sizeof (bool));
+  ring->walking = walking;
+}
+
+static uint64_t kill_satisfied_clauses (struct ring *ring) {
+  struct walking *walking = ring->walking;
+  struct flat_clauses *flat = walking->flat;
+  signed char *values = ring->values;
+  unsigned *literals = flat->literals;
+  size_t *starts = flat->starts;
+  bool *dead = walking->dead;
+  uint64_t ticks = 1;
+  unsigned killed = 0;
+  for (unsigned c = 0; c != flat->size; c++) {
+    ticks++;
+    if (dead[c])
       continue;
-    struct counters *counters = &COUNTERS (lit);
+    unsigned *begin = literals + starts[c];
+    unsigned *end = literals + starts[c + 1];
+    for (unsigned *p = begin; p != end; p++)
+      if (values[*p] > 0) {
+        dead[c] = true;
+        killed++;
+        break;
+      }
+    ticks += cache_lines (end, begin);
+  }
+  walking->killed += killed;
+  walking->fixed = ring->statistics.fixed;
+  very_verbose (ring, "killed %u satisfied clauses", killed);
+  return ticks;
+}
+
+static void prepare_walking (struct walker *walker) {
+  struct ring *ring = walker->ring;
+  assert (!ring->level);
+  uint64_t ticks = 0;
+  if (ring->walking)
+    ring->statistics.walks.reused++;
+  else
+    new_walking (ring, share_flat_clauses (ring, &ticks));
+  struct walking *walking = ring->walking;
+  if (walking->fixed != ring->statistics.fixed)
+    ticks += kill_satisfied_clauses (ring);
+  walker->extra += ticks;
+  walker->walking = walking;
+  walker->flat = walking->flat;
+}
+
+static inline void insert_unsatisfied (struct walker *walker, unsigned c) {
+  struct walking *walking = walker->walking;
+  unsigned pos = walker->unsatisfied++;
+  walking->positions[c] = pos;
+  walking->broken[pos] = c;
+}
+
+static inline void remove_unsatisfied (struct walker *walker, unsigned c) {
+  struct walking *walking = walker->walking;
+  unsigned pos = walking->positions[c];
+  assert (pos < walker->unsatisfied);
+  assert (walking->broken[pos] == c);
+  unsigned last = walking->broken[--walker->unsatisfied];
+  walking->broken[pos] = last;
+  walking->positions[last] = pos;
+}
+
+static double connect_clauses (struct walker *walker) {
+  struct ring *ring = walker->ring;
+  struct flat_clauses *flat = walker->flat;
+  struct walking *walking = walker->walking;
+  signed char *values = ring->values;
+  unsigned *literals = flat->literals;
+  size_t *starts = flat->starts;
+  unsigned *counts = walking->counts;
+  bool *dead = walking->dead;
+  double sum_lengths = 0;
+  size_t clauses = 0;
+  uint64_t ticks = 1;
+  for (unsigned c = 0; c != flat->size; c++) {
     ticks++;
-    unsigned *binaries = counters->binaries;
-    if (!binaries)
+    if (dead[c]) {
+      counts[c] = DEAD_COUNT;
       continue;
-    unsigned *p, other;
-    for (p = binaries; (other = *p) != INVALID; p++) {
-      if (lit > other)
-        continue;
-      signed char other_value = values[other];
-      if (!other_value)
-        continue;
-      sum_lengths += 2;
-      clauses++;
-      if (lit_value > 0)
-        continue;
-      if (other_value > 0)
+    }
+    unsigned *begin = literals + starts[c];
+    unsigned *end = literals + starts[c + 1];
+    unsigned length = 0, count = 0;
+    for (unsigned *p = begin; p != end; p++) {
+      signed char value = values[*p];
+      if (!value)
         continue;
-      LOGBINARY (false, lit, other, "initially broken");
-      void *ptr = tag_binary (false, lit, other);
-      assert (ptr == min_max_tag_binary (false, lit, other));
-      set_insert (&walker->unsatisfied, ptr);
+      count += (value > 0);
+      length++;
+    }
+    ticks += cache_lines (end, begin);
+    if (!length) {
+      WOG ("WARNING: fully assigned clause %u", c);
+      counts[c] = DEAD_COUNT;
+      continue;
+    }
+    sum_lengths += length;
+    counts[c] = count;
+    if (!count) {
+      insert_unsatisfied (walker, c);
+      WOG ("clause %u initially broken", c);
       ticks++;
     }
-    ticks += cache_lines (p, binaries);
-    if (*terminate)
-      break;
+    clauses++;
   }
 
-  very_verbose (ring, "connecting counters took %" PRIu64 " extra ticks",
+  very_verbose (ring, "connecting clauses took %" PRIu64 " extra ticks",
                 ticks);
 
   walker->extra += ticks;
@@ -261,6 +458,9 @@ static void import_decisions (struct walker *walker) {
     v++;
   }
   assert (q == values + 2 * ring->size);
+#ifdef PACKED_VALUES
+  pack_values (ring);
+#endif
   verbose (ring, "imported %u positive %u negative decisions (%u ignored)",
            pos, neg, ignored);
 }
@@ -273,6 +473,9 @@ static void fix_values_after_local_search (struct ring *ring) {
     values[NOT (lit)] = -1;
     VAR (lit)->level = 0;
   }
+#ifdef PACKED_VALUES
+  pack_values (ring);
+#endif
 }
 
 static void set_walking_limits (struct walker *walker) {
@@ -284,7 +487,11 @@ static void set_walking_limits (struct walker *walker) {
   uint64_t ticks = search - last->walk;
   ticks = MAX (MIN_ABSOLUTE_FFORT, ticks);
   uint64_t extra = walker->extra;
-  uint64_t effort = extra + WALK_EFFORT * ticks;
+  uint64_t effort = extra;
+  if (ring->walker)
+    effort += ticks; // Dedicated walker rings do not search.
+  else
+    effort += WALK_EFFORT * ticks;
   walker->limit = walk + effort;
   very_verbose (ring,
                 "walking effort %" PRIu64 " ticks = "
@@ -294,41 +501,24 @@ static void set_walking_limits (struct walker *walker) {
                 (double) WALK_EFFORT, search, last->walk);
 }
 
-static size_t hash_counter_or_binary (void *state, void *ptr) {
-  if (is_binary_pointer (ptr))
-    return (size_t) ptr;
-  struct counter *counters = state;
-  struct counter *counter = ptr;
-  assert (counters <= counter);
-  size_t res = counter - counters;
-  return res;
-}
-
 static struct walker *new_walker (struct ring *ring) {
-  struct clause *last = 0;
-  size_t clauses = count_irredundant_non_garbage_clauses (ring, &last);
+  struct walker *walker = allocate_and_clear_block (sizeof *walker);
+  walker->ring = ring;
 
+  prepare_walking (walker);
+#ifndef QUIET
+  size_t clauses = walker->flat->size - walker->walking->killed;
   verbose (ring, "local search over %zu clauses %.0f%%", clauses,
            percent (clauses, ring->statistics.irredundant));
-
-  struct walker *walker = allocate_and_clear_block (sizeof *walker);
-  walker->ring = ring;
+#endif
 
   import_decisions (walker);
-  disconnect_references (ring, &walker->saved);
-
-  walker->counters =
-      allocate_and_clear_array (clauses, sizeof *walker->counters);
-  walker->occurrences = (struct counters *) ring->references;
 
-  walker->unsatisfied.hash.function = hash_counter_or_binary;
-  walker->unsatisfied.hash.state = walker->counters;
-
-  double length = connect_counters (walker, last);
+  double length = connect_clauses (walker);
   set_walking_limits (walker);
   initialize_break_table (walker, length);
 
-  walker->initial = walker->minimum = walker->unsatisfied.size;
+  walker->initial = walker->minimum = walker->unsatisfied;
   verbose (ring, "initially %zu clauses unsatisfied", walker->minimum);
 
   return walker;
@@ -336,41 +526,33 @@ static struct walker *new_walker (struct ring *ring) {
 
 static void delete_walker (struct walker *walker) {
   struct ring *ring = walker->ring;
-  free (walker->counters);
-  free (walker->unsatisfied.table);
+  if (!ring->options.walk_persistent)
+    release_walking (ring);
+  else {
+    size_t bytes = ring->walking->bytes;
+    if (bytes > ring->statistics.walks.kept)
+      ring->statistics.walks.kept = bytes;
+    very_verbose (ring, "keeping %zu bytes of local search state", bytes);
+  }
   RELEASE (walker->literals);
   RELEASE (walker->trail);
   RELEASE (walker->scores);
   RELEASE (walker->breaks);
-  release_references (ring);
-  reconnect_watches (ring, &walker->saved);
-  RELEASE (walker->saved);
   free (walker);
 }
 
 static unsigned break_count (struct walker *walker, unsigned lit) {
   struct ring *ring = walker->ring;
-  signed char *values = ring->values;
+  struct flat_clauses *flat = walker->flat;
   unsigned not_lit = NOT (lit);
-  assert (values[not_lit] > 0);
+  assert (ring->values[not_lit] > 0);
+  const unsigned *counts = walker->walking->counts;
+  const unsigned *begin = BEGIN_OCCURRENCES (not_lit);
+  const unsigned *end = END_OCCURRENCES (not_lit);
   unsigned res = 0;
-  struct counters *counters = &COUNTERS (not_lit);
-  unsigned *binaries = counters->binaries;
-  uint64_t ticks = 1;
-  if (binaries) {
-    unsigned *p, other;
-    for (p = binaries; (other = *p) != INVALID; p++)
-      if (values[other] <= 0)
-        res++;
-    ticks += cache_lines (p, binaries);
-  }
-  for (all_counters (counter, *counters)) {
-    ticks++;
-    assert (!is_binary_pointer (counter));
-    if (counter->count == 1)
-      res++;
-  }
-  ring->statistics.contexts[WALK_CONTEXT].ticks += ticks;
+  for (const unsigned *p = begin; p != end; p++)
+    res += (counts[*p] == 1);
+  ring->statistics.contexts[WALK_CONTEXT].ticks += 1 + (end - begin);
   return res;
 }
 
@@ -473,7 +655,7 @@ static void new_minimium (struct walker *walker, unsigned unsatisfied) {
 static void update_minimum (struct walker *walker, unsigned lit) {
   (void) lit;
 
-  unsigned unsatisfied = walker->unsatisfied.size;
+  unsigned unsatisfied = walker->unsatisfied;
   WOG ("making literal %s gives %u unsatisfied clauses", LOGLIT (lit),
        unsatisfied);
 
@@ -483,63 +665,42 @@ static void update_minimum (struct walker *walker, unsigned lit) {
 
 static void make_literal (struct walker *walker, unsigned lit) {
   struct ring *ring = walker->ring;
-  signed char *values = ring->values;
-  assert (values[lit] > 0);
+  struct flat_clauses *flat = walker->flat;
+  assert (ring->values[lit] > 0);
+  unsigned *counts = walker->walking->counts;
+  const unsigned *begin = BEGIN_OCCURRENCES (lit);
+  const unsigned *end = END_OCCURRENCES (lit);
   uint64_t ticks = 1;
-  struct counters *counters = &COUNTERS (lit);
-  for (all_counters (counter, *counters)) {
+  for (const unsigned *p = begin; p != end; p++) {
+    unsigned c = *p;
     ticks++;
-    assert (!is_binary_pointer (counter));
-    if (counter->count++)
+    if (counts[c]++)
       continue;
-    LOGCLAUSE (counter->clause, "literal %s makes", LOGLIT (lit));
-    set_remove (&walker->unsatisfied, counter);
+    WOG ("literal %s makes clause %u", LOGLIT (lit), c);
+    remove_unsatisfied (walker, c);
     ticks++;
   }
-  unsigned *binaries = counters->binaries;
-  if (binaries) {
-    unsigned *p, other;
-    for (p = binaries; (other = *p) != INVALID; p++)
-      if (values[other] < 0) {
-        LOGBINARY (false, lit, other, "literal %s makes", LOGLIT (lit));
-        void *ptr = min_max_tag_binary (false, lit, other);
-        set_remove (&walker->unsatisfied, ptr);
-        ticks++;
-      }
-    ticks += cache_lines (p, binaries);
-  }
   ring->statistics.contexts[WALK_CONTEXT].ticks += ticks;
 }
 
 static void break_literal (struct walker *walker, unsigned lit) {
   struct ring *ring = walker->ring;
-  signed char *values = ring->values;
-  assert (values[lit] < 0);
+  struct flat_clauses *flat = walker->flat;
+  assert (ring->values[lit] < 0);
+  unsigned *counts = walker->walking->counts;
+  const unsigned *begin = BEGIN_OCCURRENCES (lit);
+  const unsigned *end = END_OCCURRENCES (lit);
   uint64_t ticks = 1;
-  struct counters *counters = &COUNTERS (lit);
-  for (all_counters (counter, *counters)) {
+  for (const unsigned *p = begin; p != end; p++) {
+    unsigned c = *p;
     ticks++;
-    assert (!is_binary_pointer (counter));
-    assert (counter->count);
-    if (--counter->count)
+    assert (counts[c]);
+    if (--counts[c])
       continue;
-    LOGCLAUSE (counter->clause, "literal %s breaks", LOGLIT (lit));
-    set_insert (&walker->unsatisfied, counter);
+    WOG ("literal %s breaks clause %u", LOGLIT (lit), c);
+    insert_unsatisfied (walker, c);
     ticks++;
   }
-  unsigned *binaries = counters->binaries;
-  if (binaries) {
-    ticks++;
-    unsigned *p, other;
-    for (p = binaries; (other = *p) != INVALID; p++)
-      if (values[other] < 0) {
-        LOGBINARY (false, lit, other, "literal %s breaks", LOGLIT (lit));
-        void *ptr = min_max_tag_binary (false, lit, other);
-        set_insert (&walker->unsatisfied, ptr);
-        ticks++;
-      }
-    ticks += cache_lines (p, binaries);
-  }
   ring->statistics.contexts[WALK_CONTEXT].ticks += ticks;
 }
 
@@ -551,6 +712,9 @@ static void flip_literal (struct walker *walker, unsigned lit) {
   walker->flips++;
   unsigned not_lit = NOT (lit);
   values[lit] = 1, values[not_lit] = -1;
+#ifdef PACKED_VALUES
+  assign_packed_value (ring->packed, lit);
+#endif
   break_literal (walker, not_lit);
   make_literal (walker, lit);
 }
@@ -561,7 +725,11 @@ static unsigned pick_literal_to_flip (struct walker *walker, size_t size,
   assert (EMPTY (walker->scores));
 
   struct ring *ring = walker->ring;
+#ifdef PACKED_VALUES
+  const unsigned char *packed = ring->packed;
+#else
   signed char *values = ring->values;
+#endif
 
   unsigned res = INVALID;
   double total = 0, score = -1;
@@ -570,7 +738,7 @@ static unsigned pick_literal_to_flip (struct walker *walker, size_t size,
 
   for (unsigned *p = literals; p != end; p++) {
     unsigned lit = *p;
-    if (!values[lit])
+    if (!VALUE (lit))
       continue;
     PUSH (walker->literals, lit);
     score = break_score (walker, lit);
@@ -591,7 +759,7 @@ static unsigned pick_literal_to_flip (struct walker *walker, size_t size,
   unsigned *p = literals;
   while (p != end) {
     unsigned other = *p++;
-    if (!values[other])
+    if (!VALUE (other))
       continue;
     double tmp = *scores++;
     sum += tmp;
@@ -614,23 +782,18 @@ static unsigned pick_literal_to_flip (struct walker *walker, size_t size,
 }
 
 static void walking_step (struct walker *walker) {
-  struct set *unsatisfied = &walker->unsatisfied;
   struct ring *ring = walker->ring;
-  struct counter *counter = random_set (&ring->random, unsatisfied);
-  unsigned lit;
-  if (is_binary_pointer (counter)) {
-    unsigned first = lit_pointer (counter);
-    unsigned second = other_pointer (counter);
-    assert (!redundant_pointer (counter));
-    unsigned literals[2] = {first, second};
-    LOGBINARY (false, first, second, "picked broken");
-    lit = pick_literal_to_flip (walker, 2, literals);
-  } else {
-    assert (!counter->count);
-    struct clause *clause = counter->clause;
-    LOGCLAUSE (clause, "picked broken");
-    lit = pick_literal_to_flip (walker, clause->size, clause->literals);
-  }
+  struct flat_clauses *flat = walker->flat;
+  struct walking *walking = walker->walking;
+  assert (walker->unsatisfied);
+  size_t pos = random_modulo (&ring->random, walker->unsatisfied);
+  unsigned c = walking->broken[pos];
+  assert (!walking->counts[c]);
+  size_t start = flat->starts[c];
+  size_t size = flat->starts[c + 1] - start;
+  unsigned *literals = flat->literals + start;
+  WOG ("picked broken clause %u of size %zu", c, size);
+  unsigned lit = pick_literal_to_flip (walker, size, literals);
   flip_literal (walker, lit);
   push_flipped (walker, lit);
   update_minimum (walker, lit);
@@ -641,10 +804,13 @@ static void walking_loop (struct walker *walker) {
   uint64_t *ticks = &ring->statistics.contexts[WALK_CONTEXT].ticks;
   uint64_t limit = walker->limit;
   volatile bool *terminate = &ring->ruler->terminate;
+  volatile bool *simplify = &ring->ruler->simplify;
+  bool walker_ring = ring->walker;
 #ifndef QUIET
   uint64_t ticks_before = *ticks;
 #endif
-  while (walker->minimum && *ticks <= limit && !*terminate)
+  while (walker->minimum && *ticks <= limit && !*terminate &&
+         !(walker_ring && *simplify))
     walking_step (walker);
 #ifndef QUIET
   uint64_t ticks_after = *ticks;
@@ -663,8 +829,12 @@ void local_search (struct ring *ring) {
   if (ring->last.fixed != ring->statistics.fixed)
     mark_satisfied_watchers_as_garbage (ring);
   {
+    START (ring, connect);
     struct walker *walker = new_walker (ring);
+    STOP (ring, connect);
+    START (ring, flip);
     walking_loop (walker);
+    STOP (ring, flip);
     save_final_minimum (walker);
     verbose (ring, "walker flipped %" PRIu64 " literals", walker->flips);
     delete_walker (walker);
@@ -675,3 +845,72 @@ void local_search (struct ring *ring) {
   ring->context = SEARCH_CONTEXT;
   STOP_AND_START_SEARCH (walk);
 }
+
+/*------------------------------------------------------------------------*/
+
+// Dedicated walker rings (see 'solve.c') do not search but keep walking on
+// the irredundant clauses.  After each round they publish their best
+// assignment as saved phases to all other rings, which adopt them when
+// rephasing.  In the other direction, the searching rings publish their
+// target phases to the walker rings at every rephase, which then restart
+// walking from those.  Each ring has a single slot 'published' which
+// holds a pointer to an array of phases and is exchanged atomically.  The
+// old content of the slot is freed if it was not adopted yet.
+
+static void publish_phases (struct ring *ring, struct ring *other,
+                            bool target) {
+  signed char *phases = allocate_array (ring->size, sizeof *phases);
+  signed char *q = phases;
+  for (all_phases (p))
+    *q++ = target ? p->target : p->saved;
+  uintptr_t previous = atomic_exchange (&other->published,
+                                        (uintptr_t) phases);
+  free ((void *) previous);
+  ring->statistics.phases.published++;
+}
+
+static bool adopt_published_phases (struct ring *ring) {
+  uintptr_t published = atomic_exchange (&ring->published, 0);
+  if (!published)
+    return false;
+  signed char *q = (signed char *) published;
+  for (all_phases (p)) {
+    signed char phase = *q++;
+    if (phase)
+      p->saved = phase;
+  }
+  free ((void *) published);
+  ring->statistics.phases.adopted++;
+  return true;
+}
+
+void publish_target_phases (struct ring *ring) {
+  assert (!ring->walker);
+  struct ruler *ruler = ring->ruler;
+  for (all_rings (other))
+    if (other->walker)
+      publish_phases (ring, other, true);
+}
+
+bool adopt_walked_phases (struct ring *ring) {
+  assert (!ring->walker);
+  if (!adopt_published_phases (ring))
+    return false;
+  verbose (ring, "adopted phases published by walker rings");
+  return true;
+}
+
+void dedicated_local_search (struct ring *ring) {
+  assert (ring->walker);
+  if (import_shared (ring))
+    return;
+  if (adopt_published_phases (ring))
+    very_verbose (ring, "restart walking from published target phases");
+  local_search (ring);
+  if (ring->inconsistent || terminate_ring (ring))
+    return;
+  struct ruler *ruler = ring->ruler;
+  for (all_rings (other))
+    if (!other->walker)
+      publish_phases (ring, other, false);
+}
@@ -1,14 +1,17 @@
 #ifndef _walk_h_INCLUDED
 #define _walk_h_INCLUDED
 
-struct ring;
-struct clause;
+#include <stdbool.h>
 
-struct counter {
-  unsigned count;
-  struct clause *clause;
-};
+struct ring;
+struct ruler;
 
 void local_search (struct ring *);
+void release_walking (struct ring *);
+void release_flat_clauses (struct ruler *);
+void dedicated_local_search (struct ring *);
+
+void publish_target_phases (struct ring *);
+bool adopt_walked_phases (struct ring *);
 
 #endif
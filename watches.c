@@ -1,5 +1,6 @@
 #include "watches.h"
 #include "clause.h"
+#include "import.h"
 #include "message.h"
 #include "ring.h"
 #include "tagging.h"
@@ -15,54 +16,6 @@ void release_references (struct ring *ring) {
       RELEASE (REFERENCES (lit));
 }
 
-void disconnect_references (struct ring *ring, struct watches *saved) {
-#ifndef QUIET
-  size_t disconnected = 0;
-#endif
-  for (all_ring_literals (lit)) {
-    struct references *watches = &REFERENCES (lit);
-    for (all_watches (watch, *watches))
-      if (is_binary_pointer (watch)) {
-        assert (redundant_pointer (watch));
-        assert (lit_pointer (watch) == lit);
-        unsigned other = other_pointer (watch);
-        if (other < lit)
-          PUSH (*saved, watch);
-      }
-#ifndef QUIET
-    disconnected += SIZE (*watches);
-#endif
-    RELEASE (*watches);
-  }
-  very_verbose (ring, "disconnected %zu clauses", disconnected);
-}
-
-void reconnect_watches (struct ring *ring, struct watches *saved) {
-#ifndef QUIET
-  size_t reconnected = 0;
-#endif
-  for (all_watchers (watcher)) {
-    unsigned *literals = watcher->clause->literals;
-    watcher->sum = literals[0] ^ literals[1];
-    watch_literal (ring, literals[0], literals[1], watcher);
-    watch_literal (ring, literals[1], literals[0], watcher);
-#ifndef QUIET
-    reconnected++;
-#endif
-  }
-  for (all_watches (lit_watch, *saved)) {
-    assert (is_binary_pointer (lit_watch));
-    assert (redundant_pointer (lit_watch));
-    unsigned lit = lit_pointer (lit_watch);
-    unsigned other = other_pointer (lit_watch);
-    struct watch *other_watch = tag_binary (true, other, lit);
-    push_watch (ring, lit, lit_watch);
-    push_watch (ring, other, other_watch);
-  }
-  very_verbose (ring, "reconnected %zu clauses", reconnected);
-  ring->trail.propagate = ring->trail.begin;
-}
-
 struct watch *watch_literals_in_large_clause (struct ring *ring,
                                               struct clause *clause,
                                               unsigned first,
@@ -87,8 +40,13 @@ struct watch *watch_literals_in_large_clause (struct ring *ring,
                  (size_t) MAX_WATCHER_INDEX, ring->id);
   unsigned idx = size_watchers;
 
-  if (FULL (ring->watchers))
+  if (FULL (ring->watchers)) {
     ENLARGE (ring->watchers);
+    if (ring->options.huge_pages) {
+      size_t bytes = CAPACITY (ring->watchers) * sizeof (struct watcher);
+      advise_huge_pages (ring->watchers.begin, bytes);
+    }
+  }
   struct watcher *watcher = ring->watchers.end++;
   assert (ring->watchers.end <= ring->watchers.allocated);
 
@@ -122,6 +80,9 @@ struct watch *watch_literals_in_large_clause (struct ring *ring,
   watcher->reason = false;
   watcher->redundant = redundant;
   watcher->vivify = false;
+  watcher->analyzed = false;
+  watcher->propagated = false;
+  watcher->imported = 0;
 
   watcher->sum = first ^ second;
   watcher->clause = clause;
@@ -176,8 +137,8 @@ unsigned *flush_watchers (struct ring *ring, unsigned start) {
   unsigned dst = start;
 
   unsigned redundant = 0;
-#ifndef QUIET
   unsigned flushed = 0;
+#ifndef QUIET
   unsigned deleted = 0;
   unsigned mapped = 0;
 #endif
@@ -191,10 +152,10 @@ unsigned *flush_watchers (struct ring *ring, unsigned start) {
       struct clause *clause = p->clause;
 #ifndef QUIET
       deleted += dereference_clause (ring, clause);
-      flushed++;
 #else
       (void) dereference_clause (ring, clause);
 #endif
+      flushed++;
     } else {
       *q++ = *p;
 
@@ -210,6 +171,8 @@ unsigned *flush_watchers (struct ring *ring, unsigned start) {
     }
   }
   watchers->end = q;
+  assert (ring->garbage >= flushed);
+  ring->garbage -= flushed;
 
   verbose (ring, "mapped %u non-garbage watchers %.0f%%", mapped,
            percent (mapped, size));
@@ -234,6 +197,9 @@ void mark_garbage_watcher (struct ring *ring, struct watcher *watcher) {
   LOGCLAUSE (watcher->clause, "marking garbage watcher to");
   assert (!watcher->garbage);
   watcher->garbage = true;
+  if (watcher->imported)
+    retire_imported_watcher (ring, watcher);
+  ring->garbage++;
   dec_clauses (ring, watcher->redundant);
 }
 
@@ -21,6 +21,9 @@ struct watcher {
   bool reason : 1;
   bool redundant : 1;
   bool vivify : 1;
+  bool analyzed : 1;
+  bool propagated : 1;
+  unsigned char imported : 2; // tier of imported clause (0 = local)
   unsigned sum;
   struct clause *clause;
   unsigned aux[SIZE_WATCHER_LITERALS];
@@ -52,7 +55,6 @@ struct watches {
 
 struct references {
   struct watch **begin, **end, **allocated;
-  unsigned *binaries;
 };
 
 /*------------------------------------------------------------------------*/
@@ -64,11 +66,14 @@ struct references {
   unsigned *P_##LIT = \
       ((WATCHER)->size ? (WATCHER)->aux : (WATCHER)->clause->literals), \
            *END_##LIT = \
-               P_##LIT + ((WATCHER)->size ? (WATCHER)->size \
-                                          : (WATCHER)->clause->size), \
-           LIT; \
-  P_##LIT != END_##LIT && (LIT = *P_##LIT, true); \
-  ++P_##LIT
+               P_##LIT + ((WATCHER)->size \
+                              ? (WATCHER)->size \
+                              : head_size_of_clause ((WATCHER)->clause)), \
+           TAIL_##LIT = (WATCHER)->size \
+                            ? 0 \
+                            : tail_size_of_clause ((WATCHER)->clause), \
+           POS_##LIT = 0, LIT = 0; \
+  NEXT_LITERAL_IN_CLAUSE (LIT);
 
 /*------------------------------------------------------------------------*/
 
@@ -87,10 +92,8 @@ void mark_garbage_watch (struct ring *, struct watch *);
 void mark_garbage_watcher (struct ring *, struct watcher *);
 
 unsigned *flush_watchers (struct ring *, unsigned start);
-void reconnect_watches (struct ring *, struct watches *saved);
 
 void release_references (struct ring *);
-void disconnect_references (struct ring *, struct watches *);
 void sort_redundant_watcher_indices (struct ring *, size_t, unsigned *);
 
 /*------------------------------------------------------------------------*/